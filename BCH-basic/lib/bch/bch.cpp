@@ -2,83 +2,140 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 
-BCHEncoder::BCHEncoder(int m, int t, uint16_t primitivePoly)
-    : m(m), t(t), primitivePoly(primitivePoly), n(0), k(0) {
-    // Use default primitive polynomial if not provided
-    if (primitivePoly == 0) {
-        this->primitivePoly = getDefaultPrimitivePoly(m);
+namespace {
+
+// Shift a packed register left by s (1..63) bits, keeping its low `bits` bits
+void shiftLeftMasked(uint64_t* words, int count, int s, int bits) {
+    for (int i = count - 1; i > 0; i--) {
+        words[i] = (words[i] << s) | (words[i - 1] >> (64 - s));
     }
+    words[0] <<= s;
 
-    n = (1 << m) - 1;  // n = 2^m - 1
+    int topBits = bits - 64 * (count - 1);
+    if (topBits < 64) words[count - 1] &= (1ULL << topBits) - 1;
 }
 
-uint16_t BCHEncoder::getDefaultPrimitivePoly(int m) {
-    // Default primitive polynomials for GF(2^m)
-    // Represented as binary: bit i represents coefficient of x^i
-    static const std::map<int, uint16_t> defaultPolys = {
-        {2, 0b111},       // x^2 + x + 1
-        {3, 0b1011},      // x^3 + x + 1
-        {4, 0b10011},     // x^4 + x + 1
-        {5, 0b100101},    // x^5 + x^2 + 1
-        {6, 0b1000011},   // x^6 + x + 1
-        {7, 0b10000011},  // x^7 + x + 1
-        {8, 0b100011101}  // x^8 + x^4 + x^3 + x^2 + 1
-    };
-
-    auto it = defaultPolys.find(m);
-    if (it != defaultPolys.end()) {
-        return it->second;
+// In-place transpose of a 64x64 bit matrix (row r = words[r], column c =
+// bit c): swap 32x32 blocks, then 16x16 blocks inside them, and so on
+void transpose64(uint64_t* words) {
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+        for (int r = 0; r < 64; r = ((r | j) + 1) & ~j) {
+            uint64_t swap = ((words[r] >> j) ^ words[r | j]) & mask;
+            words[r] ^= swap << j;
+            words[r | j] ^= swap;
+        }
     }
-
-    std::cerr << "No default primitive polynomial for m=" << m << std::endl;
-    return 0;
 }
 
-void BCHEncoder::buildGaloisField() {
-    int fieldSize = 1 << m;  // 2^m
-    alphaToInt.resize(fieldSize);
-    intToAlpha.resize(fieldSize, -1);
+// Binary descriptor: header (magic, version) followed by tagged sections,
+// each a tag, a payload length and the payload padded to 4 bytes
+const uint32_t descriptorMagic = 0x44484342;  // "BCHD"
+const uint32_t descriptorVersion = 2;
+
+enum DescriptorTag : uint32_t {
+    TagCode = 1,            // m, t, primitive polynomial, n, k, encode mode
+    TagGenerator = 2,       // g(x) coefficients, packed
+    // 3 was the field tables (version 1), now rebuilt from m and the
+    // primitive polynomial on load
+    TagRemainderTable = 4,  // tableBits, then the table entries
+    TagDecoder = 5,         // Decode method, then its syndrome table
+    TagShortening = 6       // Implicit message zeros (shortened codes only)
+};
+
+void appendBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
 
-    // α^0 = 1
-    alphaToInt[0] = 1;
-    intToAlpha[1] = 0;
+void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+    appendBytes(out, &value, sizeof(value));
+}
 
-    // Generate field elements using primitive polynomial
-    uint16_t value = 1;
-    for (int i = 1; i < fieldSize - 1; i++) {
-        // Multiply by α (shift left)
-        value <<= 1;
+// Start a section, returning the offset of its length field
+size_t beginSection(std::vector<uint8_t>& out, uint32_t tag) {
+    appendU32(out, tag);
+    appendU32(out, 0);
+    return out.size() - sizeof(uint32_t);
+}
 
-        // If overflow (bit m is set), reduce using primitive polynomial
-        if (value & (1 << m)) {
-            value ^= primitivePoly;
-        }
+void endSection(std::vector<uint8_t>& out, size_t lengthOffset) {
+    uint32_t length = out.size() - lengthOffset - sizeof(uint32_t);
+    memcpy(&out[lengthOffset], &length, sizeof(length));
+    while (out.size() % 4 != 0) out.push_back(0);
+}
 
-        alphaToInt[i] = value;
-        intToAlpha[value] = i;
+// Sequential reader over one section payload (data may be unaligned)
+struct SectionReader {
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    size_t pos = 0;
+
+    bool read(void* out, size_t size) {
+        if (size > length - pos) return false;
+        if (size == 0) return true;
+        memcpy(out, data + pos, size);
+        pos += size;
+        return true;
+    }
+};
+
+// Locate a section payload; false if it is absent or the blob is malformed
+bool findSection(const uint8_t* data, size_t size, uint32_t tag,
+                 SectionReader& reader) {
+    uint32_t header[2];
+    if (data == nullptr || size < sizeof(header)) return false;
+    memcpy(header, data, sizeof(header));
+    if (header[0] != descriptorMagic || header[1] != descriptorVersion) {
+        return false;
     }
-}
 
-uint16_t BCHEncoder::gfAdd(uint16_t a, uint16_t b) {
-    // Addition in GF(2^m) is XOR
-    return a ^ b;
+    size_t pos = sizeof(header);
+    while (size - pos >= 2 * sizeof(uint32_t)) {
+        uint32_t section[2];  // Tag, payload length
+        memcpy(section, data + pos, sizeof(section));
+        pos += sizeof(section);
+        if (section[1] > size - pos) return false;
+
+        if (section[0] == tag) {
+            reader.data = data + pos;
+            reader.length = section[1];
+            reader.pos = 0;
+            return true;
+        }
+        pos += std::min(size - pos, ((size_t)section[1] + 3) & ~(size_t)3);
+    }
+    return false;
 }
 
-uint16_t BCHEncoder::gfMultiply(uint16_t a, uint16_t b) {
-    if (a == 0 || b == 0) return 0;
-
-    // Use logarithm tables for multiplication
-    int logA = intToAlpha[a];
-    int logB = intToAlpha[b];
-    int logResult = (logA + logB) % (n);  // n = 2^m - 1
+}  // namespace
+
+BCHEncoder::BCHEncoder(int m, int t, uint32_t primitivePoly)
+    : m(m),
+      t(t),
+      primitivePoly(primitivePoly),
+      n(0),
+      k(0),
+      shortening(0),
+      encodeMode(BCHEncodeMode::BitSerial),
+      tableBits(0),
+      parityWords(0) {
+    // Use default primitive polynomial if not provided
+    if (primitivePoly == 0) {
+        this->primitivePoly = GF2m::defaultPolynomial(m);
+        if (this->primitivePoly == 0) {
+            std::cerr << "No default primitive polynomial for m=" << m
+                      << std::endl;
+        }
+    }
 
-    return alphaToInt[logResult];
+    n = (m >= 2 && m <= 16) ? (1 << m) - 1 : 0;  // n = 2^m - 1
 }
 
-
 std::vector<std::set<int>> BCHEncoder::generateCyclotomicCosets() {
     std::vector<std::set<int>> cosets;
     std::set<int> used;
@@ -106,18 +163,18 @@ std::vector<std::set<int>> BCHEncoder::generateCyclotomicCosets() {
     return cosets;
 }
 
-std::vector<uint8_t> BCHEncoder::computeMinimalPolynomial(
+std::vector<uint16_t> BCHEncoder::computeMinimalPolynomial(
     const std::set<int>& coset) {
     // Minimal polynomial is the product of (x - α^i) for all i in coset
-    std::vector<uint8_t> minPoly = {1};  // Start with 1
+    std::vector<uint16_t> minPoly = {1};  // Start with 1
 
     for (int exponent : coset) {
         // Multiply by (x - α^exponent) = (x + α^exponent) in GF(2)
         // Current polynomial: minPoly
         // New term: (x + α^exponent)
 
-        std::vector<uint8_t> term(2);
-        term[0] = alphaToInt[exponent];  // Constant term: α^exponent
+        std::vector<uint16_t> term(2);
+        term[0] = field.alpha(exponent);  // Constant term: α^exponent
         term[1] = 1;                     // x coefficient
 
         minPoly = polyMultiply(minPoly, term);
@@ -126,37 +183,35 @@ std::vector<uint8_t> BCHEncoder::computeMinimalPolynomial(
     return minPoly;
 }
 
-int BCHEncoder::polyDegree(const std::vector<uint8_t>& poly) const {
+int BCHEncoder::polyDegree(const std::vector<uint16_t>& poly) const {
     for (int i = poly.size() - 1; i >= 0; i--) {
         if (poly[i] != 0) return i;
     }
     return -1;
 }
 
-std::vector<uint8_t> BCHEncoder::polyMultiply(const std::vector<uint8_t>& a,
-                                              const std::vector<uint8_t>& b) {
+std::vector<uint16_t> BCHEncoder::polyMultiply(const std::vector<uint16_t>& a,
+                                              const std::vector<uint16_t>& b) {
     if (a.empty() || b.empty()) return {0};
 
-    std::vector<uint8_t> result(a.size() + b.size() - 1, 0);
+    std::vector<uint16_t> result(a.size() + b.size() - 1, 0);
 
+    // result(x) += a_i * x^i * b(x)
     for (size_t i = 0; i < a.size(); i++) {
-        for (size_t j = 0; j < b.size(); j++) {
-            uint16_t prod = gfMultiply(a[i], b[j]);
-            result[i + j] = gfAdd(result[i + j], prod);
-        }
+        field.multiplyAccumulate(&result[i], b.data(), a[i], b.size());
     }
 
     return result;
 }
 
 // Greatest common divisor
-std::vector<uint8_t> BCHEncoder::polyGCD(const std::vector<uint8_t>& a,
-                                         const std::vector<uint8_t>& b) {
-    std::vector<uint8_t> u = a;
-    std::vector<uint8_t> v = b;
+std::vector<uint16_t> BCHEncoder::polyGCD(const std::vector<uint16_t>& a,
+                                         const std::vector<uint16_t>& b) {
+    std::vector<uint16_t> u = a;
+    std::vector<uint16_t> v = b;
 
     while (polyDegree(v) >= 0) {
-        std::vector<uint8_t> remainder;
+        std::vector<uint16_t> remainder;
         polyDivide(u, v, remainder);
         u = v;
         v = remainder;
@@ -166,17 +221,17 @@ std::vector<uint8_t> BCHEncoder::polyGCD(const std::vector<uint8_t>& a,
 }
 
 // Least common multiple
-std::vector<uint8_t> BCHEncoder::polyLCM(const std::vector<uint8_t>& a,
-                                         const std::vector<uint8_t>& b) {
-    std::vector<uint8_t> gcd = polyGCD(a, b);
-    std::vector<uint8_t> product = polyMultiply(a, b);
-    std::vector<uint8_t> remainder;
+std::vector<uint16_t> BCHEncoder::polyLCM(const std::vector<uint16_t>& a,
+                                         const std::vector<uint16_t>& b) {
+    std::vector<uint16_t> gcd = polyGCD(a, b);
+    std::vector<uint16_t> product = polyMultiply(a, b);
+    std::vector<uint16_t> remainder;
     return polyDivide(product, gcd, remainder);
 }
 
-std::vector<uint8_t> BCHEncoder::polyDivide(
-    const std::vector<uint8_t>& dividend, const std::vector<uint8_t>& divisor,
-    std::vector<uint8_t>& remainder) {
+std::vector<uint16_t> BCHEncoder::polyDivide(
+    const std::vector<uint16_t>& dividend, const std::vector<uint16_t>& divisor,
+    std::vector<uint16_t>& remainder) {
     remainder = dividend;
     int degDivisor = polyDegree(divisor);
 
@@ -185,7 +240,7 @@ std::vector<uint8_t> BCHEncoder::polyDivide(
         return {0};
     }
 
-    std::vector<uint8_t> quotient;
+    std::vector<uint16_t> quotient;
     uint16_t leadCoeff = divisor[degDivisor];
 
     while (polyDegree(remainder) >= degDivisor) {
@@ -196,11 +251,7 @@ std::vector<uint8_t> BCHEncoder::polyDivide(
 
         // In GF(2^m), division by leadCoeff
         if (leadCoeff != 1) {
-            // Find multiplicative inverse
-            int logLead = intToAlpha[leadCoeff];
-            int logCoeff = intToAlpha[coeff];
-            int logQuot = (logCoeff - logLead + n) % n;
-            coeff = alphaToInt[logQuot];
+            coeff = field.divide(coeff, leadCoeff);
         }
 
         // Extend quotient if needed
@@ -210,10 +261,8 @@ std::vector<uint8_t> BCHEncoder::polyDivide(
         quotient[degDiff] = coeff;
 
         // Subtract divisor * coeff * x^degDiff from remainder
-        for (int i = 0; i <= degDivisor; i++) {
-            uint16_t prod = gfMultiply(divisor[i], coeff);
-            remainder[i + degDiff] = gfAdd(remainder[i + degDiff], prod);
-        }
+        field.multiplyAccumulate(&remainder[degDiff], divisor.data(), coeff,
+                                 degDivisor + 1);
     }
 
     if (quotient.empty()) quotient = {0};
@@ -242,7 +291,7 @@ void BCHEncoder::generateGeneratorPolynomial() {
 
     // Compute LCM of all minimal polynomials
     for (const auto& coset : cosets) {
-        std::vector<uint8_t> minPoly = computeMinimalPolynomial(coset);
+        std::vector<uint16_t> minPoly = computeMinimalPolynomial(coset);
 
         std::cout << "  Minimal polynomial for coset: ";
         for (int i = polyDegree(minPoly); i >= 0; i--) {
@@ -278,53 +327,214 @@ bool BCHEncoder::initialize() {
     std::cout << "Primitive polynomial: 0x" << std::hex << primitivePoly
               << std::dec << std::endl;
 
+    if (m < 2 || m > 16 || primitivePoly == 0) {
+        std::cerr << "Unsupported field GF(2^" << m << ")" << std::endl;
+        return false;
+    }
+
     // Step 1: Build Galois Field
-    buildGaloisField();
+    if (!field.initialize(m, primitivePoly)) return false;
     std::cout << " Galois Field GF(2^" << m << ") constructed" << std::endl;
 
     // Step 2: Generate generator polynomial
     generateGeneratorPolynomial();
+    shortening = 0;
     std::cout << " Generator polynomial g(x) constructed" << std::endl;
     std::cout << "  Degree: " << polyDegree(generatorPoly) << std::endl;
     std::cout << "  Message length k: " << k << std::endl;
 
+    // Step 3: Parity register for the table-driven encoder
+    buildRemainderTable();
+
     return true;
 }
 
+bool BCHEncoder::setMessageLength(int messageLength) {
+    if (k == 0 || messageLength < 1 || messageLength > k) {
+        std::cerr << "Error: Message length must be 1.." << k << ", got "
+                  << messageLength << std::endl;
+        return false;
+    }
+    shortening = k - messageLength;
+    return true;
+}
+
+void BCHEncoder::setEncodeMode(BCHEncodeMode mode) {
+    encodeMode = mode;
+
+    // Tables depend on g(x), so they can only be built after initialize()
+    if (k > 0) {
+        buildRemainderTable();
+    }
+}
+
+void BCHEncoder::lfsrShiftIn(uint64_t* reg, int bit) const {
+    // reg = (reg * x + bit * x^(n-k)) mod g(x)
+    int parityBits = n - k;
+    int top = (parityBits - 1) / 64;
+    int feedback = bit ^ (int)((reg[top] >> ((parityBits - 1) % 64)) & 1);
+
+    shiftLeftMasked(reg, parityWords, 1, parityBits);
+
+    if (feedback) {
+        for (int w = 0; w < parityWords; w++) {
+            reg[w] ^= generatorLow[w];
+        }
+    }
+}
+
+void BCHEncoder::buildRemainderTable() {
+    int parityBits = n - k;
+    parityWords = (parityBits + 63) / 64;
+
+    // x^(n-k) mod g(x) is g(x) without its leading term
+    generatorLow.assign(parityWords, 0);
+    for (int i = 0; i < parityBits; i++) {
+        if (generatorPoly[i] != 0) {
+            generatorLow[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+
+    // The register must be at least as wide as one table step
+    tableBits = 0;
+    if (encodeMode == BCHEncodeMode::Table16 && parityBits >= 16) {
+        tableBits = 16;
+    } else if (encodeMode != BCHEncodeMode::BitSerial && parityBits >= 8) {
+        tableBits = 8;
+    }
+
+    if (tableBits == 0) {
+        remainderTable.clear();
+        return;
+    }
+
+    size_t entries = (size_t)1 << tableBits;
+    remainderTable.assign(entries * parityWords, 0);
+
+    // Single-bit entries: x^(n-k+b) mod g(x)
+    for (int b = 0; b < tableBits; b++) {
+        uint64_t* entry = &remainderTable[((size_t)1 << b) * parityWords];
+        lfsrShiftIn(entry, 1);
+        for (int i = 0; i < b; i++) {
+            lfsrShiftIn(entry, 0);
+        }
+    }
+
+    // Remaining entries by linearity: T[i] = T[i - lowest bit] + T[lowest bit]
+    for (size_t i = 3; i < entries; i++) {
+        size_t lowest = i & (~i + 1);
+        if (lowest == i) continue;
+
+        uint64_t* entry = &remainderTable[i * parityWords];
+        const uint64_t* rest = &remainderTable[(i ^ lowest) * parityWords];
+        const uint64_t* bit = &remainderTable[lowest * parityWords];
+        for (int w = 0; w < parityWords; w++) {
+            entry[w] = rest[w] ^ bit[w];
+        }
+    }
+}
+
 std::vector<uint8_t> BCHEncoder::encode(const std::vector<uint8_t>& message) {
-    if (message.size() != (size_t)k) {
-        std::cerr << "Error: Message length must be " << k << " bits, got "
-                  << message.size() << std::endl;
+    if (message.size() != (size_t)getK()) {
+        std::cerr << "Error: Message length must be " << getK()
+                  << " bits, got " << message.size() << std::endl;
         return {};
     }
 
-    // Step 1: Scale source information by multiplying by x^(n-k)
-    // This shifts the message to the left by (n-k) positions
-    std::vector<uint8_t> scaledMessage(n, 0);
+    std::vector<uint64_t> packedMessage(packedWords(getK()));
+    std::vector<uint64_t> codeword(packedWords(getN()));
+
+    packBits(message, packedMessage.data());
+    encodePacked(packedMessage.data(), codeword.data());
+
+    return unpackBits(codeword.data(), getN());
+}
+
+uint64_t BCHEncoder::encodePacked(uint64_t message) const {
+    if (getN() > 64) {
+        std::cerr << "Error: Single-word encoding needs n <= 64, got "
+                  << getN() << std::endl;
+        return 0;
+    }
+
+    // Shortened codes: the implicit leading zeros leave the remainder alone
     int parityBits = n - k;
+    message &= (1ULL << getK()) - 1;
+
+    uint64_t parity = 0;
+    parityRemainder(&message, 0, getK(), &parity);
 
-    for (int i = 0; i < k; i++) {
-        scaledMessage[i + parityBits] = message[i];
+    return parity | (message << parityBits);
+}
+
+void BCHEncoder::encodePacked(const uint64_t* message,
+                              uint64_t* codeword) const {
+    int parityBits = n - k;
+    int messageBits = getK();
+    int codeWords = packedWords(getN());
+
+    for (int w = 0; w < codeWords; w++) {
+        codeword[w] = 0;
     }
 
-    // Step 2: Divide scaled message by generator polynomial
-    std::vector<uint8_t> remainder;
-    polyDivide(scaledMessage, generatorPoly, remainder);
+    // Parity bits: remainder of x^(n-k) * m(x) divided by g(x)
+    parityRemainder(message, 0, messageBits, codeword);
 
-    // Step 3: Create systematic codeword: message + parity
-    std::vector<uint8_t> codeword(n, 0);
+    // Original message in the upper k positions
+    for (int i = 0; i < messageBits; i += 64) {
+        int len = std::min(64, messageBits - i);
+        depositBits(codeword, parityBits + i, len,
+                    extractBits(message, i, len));
+    }
+}
+
+void BCHEncoder::parityRemainder(const uint64_t* bits, int offset, int count,
+                                 uint64_t* reg) const {
+    int parityBits = n - k;
 
-    // Add parity bits (remainder) to the beginning
-    for (size_t i = 0; i < remainder.size() && i < (size_t)parityBits; i++) {
-        codeword[i] = remainder[i];
+    // Feed the bits from the highest coefficient down
+    int pos = offset + count;
+    if (tableBits > 0) {
+        while (pos - offset >= tableBits) {
+            pos -= tableBits;
+
+            uint32_t index = (uint32_t)(
+                extractBits(bits, pos, tableBits) ^
+                extractBits(reg, parityBits - tableBits, tableBits));
+            shiftLeftMasked(reg, parityWords, tableBits, parityBits);
+
+            const uint64_t* entry =
+                &remainderTable[(size_t)index * parityWords];
+            for (int w = 0; w < parityWords; w++) {
+                reg[w] ^= entry[w];
+            }
+        }
+    }
+
+    // Leftover bits (count not a multiple of the step) one at a time
+    while (pos > offset) {
+        pos--;
+        lfsrShiftIn(reg, (int)((bits[pos / 64] >> (pos % 64)) & 1));
     }
+}
 
-    // Add original message to the end
-    for (int i = 0; i < k; i++) {
-        codeword[i + parityBits] = message[i];
+void BCHEncoder::packBits(const std::vector<uint8_t>& bits, uint64_t* words) {
+    int count = packedWords(bits.size());
+    for (int w = 0; w < count; w++) {
+        words[w] = 0;
+    }
+    for (size_t i = 0; i < bits.size(); i++) {
+        words[i / 64] |= (uint64_t)(bits[i] & 1) << (i % 64);
     }
+}
 
-    return codeword;
+std::vector<uint8_t> BCHEncoder::unpackBits(const uint64_t* words,
+                                            int count) {
+    std::vector<uint8_t> bits(count);
+    for (int i = 0; i < count; i++) {
+        bits[i] = (words[i / 64] >> (i % 64)) & 1;
+    }
+    return bits;
 }
 
 void BCHEncoder::printCodeInfo() const {
@@ -337,6 +547,10 @@ void BCHEncoder::printCodeInfo() const {
     std::cout << "  d_min (minimum distance): " << (2 * t + 1) << std::endl;
     std::cout << "  Parity bits: " << (n - k) << std::endl;
     std::cout << "  Code rate: " << (float)k / n << std::endl;
+    if (shortening > 0) {
+        std::cout << "  Shortened to: (" << getN() << ", " << getK()
+                  << "), rate " << (float)getK() / getN() << std::endl;
+    }
 
     std::cout << "\nGenerator polynomial g(x): ";
     for (int i = polyDegree(generatorPoly); i >= 0; i--) {
@@ -366,60 +580,341 @@ void BCHEncoder::printCodeInfo() const {
     std::cout << "\n=========================\n" << std::endl;
 }
 
+// ============================================================================
+// BCH ENCODER IMPLEMENTATION - Bit-Sliced Batches
+// ============================================================================
+
+void BCHEncoder::toBitSlices(const uint64_t* words, int bits,
+                             uint64_t* slices) {
+    int count = packedWords(bits);
+    uint64_t block[64];
+
+    // Word w of every lane forms one 64x64 block of slices 64w..64w+63
+    for (int w = 0; w < count; w++) {
+        for (int lane = 0; lane < batchLanes; lane++) {
+            block[lane] = words[lane * count + w];
+        }
+        transpose64(block);
+
+        int len = std::min(64, bits - 64 * w);
+        for (int i = 0; i < len; i++) {
+            slices[64 * w + i] = block[i];
+        }
+    }
+}
+
+void BCHEncoder::fromBitSlices(const uint64_t* slices, int bits,
+                               uint64_t* words) {
+    int count = packedWords(bits);
+    uint64_t block[64];
+
+    for (int w = 0; w < count; w++) {
+        int len = std::min(64, bits - 64 * w);
+        for (int i = 0; i < 64; i++) {
+            block[i] = i < len ? slices[64 * w + i] : 0;
+        }
+        transpose64(block);
+
+        for (int lane = 0; lane < batchLanes; lane++) {
+            words[lane * count + w] = block[lane];
+        }
+    }
+}
+
+void BCHEncoder::batchRemainder(const uint64_t* slices, uint64_t* remainder,
+                                uint64_t* row) const {
+    int parityBits = n - k;
+    for (int j = 0; j < parityBits; j++) {
+        remainder[j] = 0;
+    }
+
+    // Message bit i contributes x^(n-k+i) mod g(x): XOR its slice into
+    // every parity slice where that row has a one
+    for (int w = 0; w < parityWords; w++) {
+        row[w] = generatorLow[w];  // x^(n-k) mod g(x)
+    }
+    for (int i = 0; i < getK(); i++) {
+        uint64_t slice = slices[i];
+        if (slice != 0) {
+            for (int w = 0; w < parityWords; w++) {
+                uint64_t bits = row[w];
+                while (bits != 0) {
+                    remainder[64 * w + __builtin_ctzll(bits)] ^= slice;
+                    bits &= bits - 1;
+                }
+            }
+        }
+        lfsrShiftIn(row, 0);  // Next row: multiply by x mod g(x)
+    }
+}
+
+void BCHEncoder::encodeBatch(const uint64_t* messageSlices,
+                             uint64_t* codewordSlices) const {
+    std::vector<uint64_t> row(parityWords);
+    encodeBatch(messageSlices, codewordSlices, row.data());
+}
+
+void BCHEncoder::encodeBatch(const uint64_t* messageSlices,
+                             uint64_t* codewordSlices,
+                             uint64_t* scratch) const {
+    int parityBits = n - k;
+
+    // Systematic code: message slices sit above the parity slices
+    if (messageSlices != codewordSlices + parityBits) {
+        for (int i = 0; i < getK(); i++) {
+            codewordSlices[parityBits + i] = messageSlices[i];
+        }
+    }
+    batchRemainder(codewordSlices + parityBits, codewordSlices, scratch);
+}
+
+void BCHEncoder::encodeBatchPacked(const uint64_t* messages,
+                                   uint64_t* codewords) const {
+    std::vector<uint64_t> slices(getN());
+    toBitSlices(messages, getK(), slices.data() + (n - k));
+    encodeBatch(slices.data() + (n - k), slices.data());
+    fromBitSlices(slices.data(), getN(), codewords);
+}
+
+// ============================================================================
+// BCH ENCODER IMPLEMENTATION - Descriptor Import/Export
+// ============================================================================
+
+std::vector<uint8_t> BCHEncoder::exportDescriptor() const {
+    std::vector<uint8_t> out;
+    if (k == 0) {
+        std::cerr << "Encoder must be initialized before export" << std::endl;
+        return out;
+    }
+    appendU32(out, descriptorMagic);
+    appendU32(out, descriptorVersion);
+
+    size_t section = beginSection(out, TagCode);
+    const uint32_t code[] = {(uint32_t)m, (uint32_t)t, primitivePoly,
+                             (uint32_t)n, (uint32_t)k,
+                             (uint32_t)encodeMode};
+    appendBytes(out, code, sizeof(code));
+    endSection(out, section);
+
+    // g(x) has binary coefficients: n-k+1 bits
+    int parityBits = n - k;
+    std::vector<uint64_t> generator(packedWords(parityBits + 1), 0);
+    for (int i = 0; i <= parityBits; i++) {
+        if (generatorPoly[i] != 0) generator[i / 64] |= 1ULL << (i % 64);
+    }
+    section = beginSection(out, TagGenerator);
+    appendBytes(out, generator.data(), generator.size() * sizeof(uint64_t));
+    endSection(out, section);
+
+    if (shortening > 0) {
+        section = beginSection(out, TagShortening);
+        appendU32(out, shortening);
+        endSection(out, section);
+    }
+
+    if (tableBits > 0) {
+        section = beginSection(out, TagRemainderTable);
+        appendU32(out, tableBits);
+        appendBytes(out, remainderTable.data(),
+                    remainderTable.size() * sizeof(uint64_t));
+        endSection(out, section);
+    }
+    return out;
+}
+
+bool BCHEncoder::loadDescriptor(const uint8_t* data, size_t size) {
+    SectionReader reader;
+    uint32_t code[6];  // m, t, primitive polynomial, n, k, encode mode
+    if (!findSection(data, size, TagCode, reader) ||
+        !reader.read(code, sizeof(code))) {
+        std::cerr << "Invalid BCH descriptor" << std::endl;
+        return false;
+    }
+    if (code[0] != (uint32_t)m || code[1] != (uint32_t)t ||
+        code[2] != primitivePoly || code[3] != (uint32_t)n || code[4] == 0 ||
+        code[4] >= (uint32_t)n ||
+        code[5] > (uint32_t)BCHEncodeMode::Table16) {
+        std::cerr << "Descriptor does not describe BCH over GF(2^" << m
+                  << ") with t=" << t << std::endl;
+        return false;
+    }
+    int loadedK = code[4];
+    int parityBits = n - loadedK;
+
+    // g(x): monic, nonzero constant term
+    std::vector<uint64_t> generator(packedWords(parityBits + 1));
+    if (!findSection(data, size, TagGenerator, reader) ||
+        !reader.read(generator.data(),
+                     generator.size() * sizeof(uint64_t)) ||
+        ((generator[parityBits / 64] >> (parityBits % 64)) & 1) == 0 ||
+        (generator[0] & 1) == 0) {
+        std::cerr << "Invalid generator polynomial in descriptor"
+                  << std::endl;
+        return false;
+    }
+
+    // Optional: absent for the full-length code
+    uint32_t loadedShortening = 0;
+    if (findSection(data, size, TagShortening, reader) &&
+        (!reader.read(&loadedShortening, sizeof(loadedShortening)) ||
+         loadedShortening >= (uint32_t)loadedK)) {
+        std::cerr << "Invalid shortening in descriptor" << std::endl;
+        return false;
+    }
+
+    // The field tables are as fast to rebuild as to copy (about 0.7 ms
+    // for m = 16) and would make up most of the descriptor
+    if (!field.initialize(m, primitivePoly)) return false;
+
+    // Everything is read; commit the code parameters
+    k = loadedK;
+    shortening = loadedShortening;
+    generatorPoly.assign(parityBits + 1, 0);
+    for (int i = 0; i <= parityBits; i++) {
+        generatorPoly[i] = (generator[i / 64] >> (i % 64)) & 1;
+    }
+
+    // Register layout (parityWords, generatorLow) without a table, then
+    // the stored table when it matches the encode mode
+    encodeMode = BCHEncodeMode::BitSerial;
+    buildRemainderTable();
+    encodeMode = (BCHEncodeMode)code[5];
+
+    uint32_t storedBits = 0;
+    if (findSection(data, size, TagRemainderTable, reader) &&
+        reader.read(&storedBits, sizeof(storedBits)) &&
+        (storedBits == 8 || storedBits == 16) &&
+        (int)storedBits <= parityBits) {
+        remainderTable.resize(((size_t)1 << storedBits) * parityWords);
+        if (reader.read(remainderTable.data(),
+                        remainderTable.size() * sizeof(uint64_t))) {
+            tableBits = storedBits;
+            return true;
+        }
+        remainderTable.clear();
+    }
+
+    if (encodeMode != BCHEncodeMode::BitSerial) {
+        buildRemainderTable();  // Not stored: rebuild for this mode
+    }
+    return true;
+}
+
 // ============================================================================
 // BCH DECODER IMPLEMENTATION - Hamming Weight Method
 // ============================================================================
 
-BCHDecoder::BCHDecoder(BCHEncoder& encoder) : encoder(encoder) {}
+void DecodeWorkspace::grow(std::vector<uint64_t>& buffer, size_t size) {
+    if (buffer.size() < size) buffer.resize(size);
+}
 
-std::vector<uint8_t> BCHDecoder::calculateSyndrome(
-    const std::vector<uint8_t>& received) {
-    // Syndrome = remainder from dividing received vector by generator
-    // polynomial
-    std::vector<uint8_t> remainder;
-    encoder.polyDivide(received, encoder.generatorPoly, remainder);
+void DecodeWorkspace::grow(std::vector<uint16_t>& buffer, size_t size) {
+    if (buffer.size() < size) buffer.resize(size);
+}
 
-    // Align syndrome length to (n-k) bits
-    int parityBits = encoder.n - encoder.k;
-    if (remainder.size() < (size_t)parityBits) {
-        remainder.resize(parityBits, 0);
+void DecodeWorkspace::reserve(const BCHEncoder& encoder) {
+    int n = encoder.getN();
+    int t = encoder.getT();
+    int parityBits = n - encoder.getK();
+    int words = BCHEncoder::packedWords(n);
+    int parityWords = BCHEncoder::packedWords(parityBits);
+
+    // Cyclic shifts work on the full 2^m - 1 bits of a shortened code
+    int fullWords = BCHEncoder::packedWords(n + encoder.getShortening());
+    grow(codeword, fullWords);
+    grow(rotated, fullWords);
+    grow(zeros, fullWords);
+    grow(corrected, words);
+    grow(syndrome, parityWords);
+    grow(row, parityWords);
+    grow(slices, n);
+    grow(sliceSyndrome, parityBits);
+    grow(powerSums, 2 * t + 1);
+    grow(locator, 2 * t + 2);
+    grow(previous, 2 * t + 2);
+    grow(saved, 2 * t + 2);
+    grow(softWords, 3 * words);
+    grow(softSyndromes, (2 + BCHDecoder::maxSoftFlips) * parityWords);
+}
+
+BCHDecoder::BCHDecoder(BCHEncoder& encoder, BCHDecodeMethod method)
+    : encoder(encoder), method(BCHDecodeMethod::ErrorTrapping) {
+    setMethod(method);
+}
+
+void BCHDecoder::setMethod(BCHDecodeMethod method) {
+    if (method == BCHDecodeMethod::SyndromeTable && !buildSyndromeTable()) {
+        method = BCHDecodeMethod::ErrorTrapping;
     }
+    this->method = method;
+}
+
+void BCHDecoder::calculateSyndrome(const uint64_t* received, int length,
+                                   uint64_t* syndrome) const {
+    // Syndrome = remainder from dividing received vector by generator
+    // polynomial. The parity part already has degree < n-k, so only the
+    // upper bits go through the division register.
+    int parityBits = encoder.n - encoder.k;
+    int words = encoder.parityWords;
 
-    return remainder;
+    for (int w = 0; w < words; w++) {
+        syndrome[w] = 0;
+    }
+    encoder.parityRemainder(received, parityBits, length - parityBits,
+                            syndrome);
+
+    for (int w = 0; w < words; w++) {
+        uint64_t low = received[w];
+        int remaining = parityBits - 64 * w;
+        if (remaining < 64) low &= (1ULL << remaining) - 1;
+        syndrome[w] ^= low;
+    }
 }
 
-int BCHDecoder::hammingWeight(const std::vector<uint8_t>& vector) {
+int BCHDecoder::hammingWeight(const uint64_t* words, int count) const {
     int weight = 0;
-    for (auto bit : vector) {
-        if (bit != 0) weight++;
+    for (int w = 0; w < count; w++) {
+        weight += __builtin_popcountll(words[w]);
     }
     return weight;
 }
 
-std::vector<uint8_t> BCHDecoder::cyclicShiftRight(
-    const std::vector<uint8_t>& vector) {
-    if (vector.empty()) return vector;
-
-    std::vector<uint8_t> shifted(vector.size());
+void BCHDecoder::cyclicShiftRight(uint64_t* words) const {
     // Shift right: last element goes to the beginning
-    shifted[0] = vector[vector.size() - 1];
-    for (size_t i = 1; i < vector.size(); i++) {
-        shifted[i] = vector[i - 1];
-    }
-    return shifted;
+    int n = encoder.n;
+    int top = (n - 1) / 64;
+    uint64_t last = (words[top] >> ((n - 1) % 64)) & 1;
+
+    shiftLeftMasked(words, BCHEncoder::packedWords(n), 1, n);
+    words[0] |= last;
 }
 
-std::vector<uint8_t> BCHDecoder::cyclicShiftLeft(
-    const std::vector<uint8_t>& vector) {
-    if (vector.empty()) return vector;
+void BCHDecoder::cyclicShiftLeft(uint64_t* words, int shifts,
+                                 uint64_t* rotated) const {
+    // Shift left: element i + shifts moves to position i
+    int n = encoder.n;
+    shifts %= n;
+    if (shifts == 0) return;
+
+    int count = BCHEncoder::packedWords(n);
+    for (int w = 0; w < count; w++) {
+        rotated[w] = 0;
+    }
+
+    for (int i = 0; i < n - shifts; i += 64) {
+        int len = std::min(64, n - shifts - i);
+        BCHEncoder::depositBits(
+            rotated, i, len, BCHEncoder::extractBits(words, shifts + i, len));
+    }
+    for (int i = 0; i < shifts; i += 64) {
+        int len = std::min(64, shifts - i);
+        BCHEncoder::depositBits(rotated, n - shifts + i, len,
+                                BCHEncoder::extractBits(words, i, len));
+    }
 
-    std::vector<uint8_t> shifted(vector.size());
-    // Shift left: first element goes to the end
-    for (size_t i = 0; i < vector.size() - 1; i++) {
-        shifted[i] = vector[i + 1];
+    for (int w = 0; w < count; w++) {
+        words[w] = rotated[w];
     }
-    shifted[vector.size() - 1] = vector[0];
-    return shifted;
 }
 
 int BCHDecoder::decode(const std::vector<uint8_t>& received,
@@ -433,8 +928,8 @@ int BCHDecoder::decode(const std::vector<uint8_t>& received,
 
     // Extract message from corrected codeword (systematic code)
     int parityBits = encoder.n - encoder.k;
-    correctedMessage.resize(encoder.k);
-    for (int i = 0; i < encoder.k; i++) {
+    correctedMessage.resize(encoder.getK());
+    for (int i = 0; i < encoder.getK(); i++) {
         correctedMessage[i] = corrected[i + parityBits];
     }
 
@@ -445,71 +940,930 @@ std::vector<uint8_t> BCHDecoder::decodeCodeword(
     const std::vector<uint8_t>& received, int& errorCount) {
     errorCount = 0;
 
-    if (received.size() != (size_t)encoder.n) {
-        std::cerr << "Error: Received word length must be " << encoder.n
+    if (received.size() != (size_t)encoder.getN()) {
+        std::cerr << "Error: Received word length must be " << encoder.getN()
                   << " bits, got " << received.size() << std::endl;
         errorCount = -1;
         return {};
     }
 
-    std::vector<uint8_t> currentVector = received;
+    int words = BCHEncoder::packedWords(encoder.getN());
+    std::vector<uint64_t> packed(words);
+    std::vector<uint64_t> corrected(words);
+
+    BCHEncoder::packBits(received, packed.data());
+    errorCount = decodeCodewordPacked(packed.data(), corrected.data());
+
+    if (errorCount < 0) {
+        return received;  // Return unchanged vector
+    }
+    return BCHEncoder::unpackBits(corrected.data(), encoder.getN());
+}
+
+int BCHDecoder::decodePacked(uint64_t received, uint64_t& correctedMessage) {
+    int errorCount;
+    uint64_t corrected = decodeCodewordPacked(received, errorCount);
+
+    if (errorCount < 0) {
+        return -1;  // Decoding failed
+    }
+
+    // Systematic code: message sits above the parity bits
+    correctedMessage = corrected >> (encoder.n - encoder.k);
+    return errorCount;
+}
+
+int BCHDecoder::decodePacked(const uint64_t* received,
+                             uint64_t* correctedMessage) {
+    return decodePacked(received, correctedMessage, workspace);
+}
+
+int BCHDecoder::decodePacked(const uint64_t* received,
+                             uint64_t* correctedMessage,
+                             DecodeWorkspace& workspace) const {
+    workspace.reserve(encoder);
+    uint64_t* corrected = workspace.corrected.data();
+    int errorCount = decodeCodewordPacked(received, corrected, workspace);
+
+    if (errorCount < 0) {
+        return -1;  // Decoding failed
+    }
+
+    int parityBits = encoder.n - encoder.k;
+    for (int i = 0; i < encoder.getK(); i += 64) {
+        int len = std::min(64, encoder.getK() - i);
+        correctedMessage[i / 64] =
+            BCHEncoder::extractBits(corrected, parityBits + i, len);
+    }
+
+    return errorCount;
+}
+
+uint64_t BCHDecoder::decodeCodewordPacked(uint64_t received,
+                                          int& errorCount) {
+    workspace.reserve(encoder);
+    return decodeWord(received, errorCount, workspace);
+}
+
+uint64_t BCHDecoder::decodeWord(uint64_t received, int& errorCount,
+                                DecodeWorkspace& workspace) const {
+    int n = encoder.getN();
+    if (n > 64) {
+        std::cerr << "Error: Single-word decoding needs n <= 64, got " << n
+                  << std::endl;
+        errorCount = -1;
+        return received;
+    }
+
+    uint64_t mask = n < 64 ? (1ULL << n) - 1 : ~0ULL;
+    uint64_t current = received & mask;
+    int cycle = encoder.n;  // Cyclic shifts span 2^m - 1 bits
+    int shortening = encoder.shortening;
+
+    if (method == BCHDecodeMethod::BerlekampMassey) {
+        uint64_t corrected;
+        errorCount = decodeAlgebraic(&current, &corrected, workspace);
+        return errorCount < 0 ? received : corrected;
+    }
+
+    if (method == BCHDecodeMethod::SyndromeTable) {
+        // One remainder, one lookup, one XOR
+        uint64_t syndrome = 0;
+        calculateSyndrome(&current, n, &syndrome);
+        errorCount = syndromeWeight[syndrome];
+        return errorCount < 0 ? received : current ^ syndromePattern[syndrome];
+    }
+
+    if (method == BCHDecodeMethod::Meggitt) {
+        // Syndrome register s = x^shifts * r(x) mod g(x), one division
+        int parityBits = encoder.n - encoder.k;
+        uint64_t generator = encoder.generatorLow[0] | 1ULL << parityBits;
+        uint64_t syndrome = 0;
+        calculateSyndrome(&current, n, &syndrome);
+        if (syndrome == 0) {
+            errorCount = 0;
+            return current;
+        }
+
+        for (int shifts = 0; shifts < cycle; shifts++) {
+            int weight = __builtin_popcountll(syndrome);
+            if (weight <= encoder.t) {
+                // Trapped: bit i of s is an error at position i - shifts
+                uint64_t errors = 0;
+                for (uint64_t bits = syndrome; bits != 0; bits &= bits - 1) {
+                    int pos = __builtin_ctzll(bits) - shifts;
+                    if (pos < 0) pos += cycle;
+                    if (pos >= n) {
+                        errorCount = -1;  // Lands on an implicit zero
+                        return received;
+                    }
+                    errors |= 1ULL << pos;
+                }
+                errorCount = weight;
+                return current ^ errors;
+            }
+
+            // Shortened code: shifts 1..shortening cannot trap errors below
+            // n that shift 0 missed, so jump past them
+            if (shifts == 0 && shortening > 0) {
+                encoder.parityRemainder(workspace.zeros.data(), 0, shortening,
+                                        &syndrome);
+                shifts += shortening;
+            }
+
+            // Next shift: s = s * x mod g(x)
+            syndrome <<= 1;
+            syndrome ^= generator & (0 - (syndrome >> parityBits));
+        }
+
+        errorCount = -1;
+        return received;
+    }
+
+    if (cycle > 64) {
+        // Shortened long code: the rotates need the full 2^m - 1 bits
+        uint64_t corrected;
+        errorCount = decodeErrorTrapping(&current, &corrected, workspace);
+        return errorCount < 0 ? received : corrected;
+    }
+
+    // Same error-trapping loop as the multi-word path, with rotates
+    uint64_t cycleMask = (1ULL << cycle) - 1;
+    for (int shifts = 0; shifts <= cycle; shifts++) {
+        uint64_t syndrome = 0;
+        calculateSyndrome(&current, cycle, &syndrome);
+        int weight = __builtin_popcountll(syndrome);
+
+        if (weight == 0 && shifts == 0) {
+            errorCount = 0;
+            return current;  // No errors
+        }
+
+        if (weight <= encoder.t) {
+            // Correction: c_D = c_Y + s, then undo the shifts
+            current ^= syndrome;
+            int back = shifts % cycle;
+            if (back != 0) {
+                current = ((current >> back) | (current << (cycle - back))) &
+                          cycleMask;
+            }
+            if ((current & ~mask) != 0) break;  // Hit an implicit zero
+            errorCount = weight;
+            return current;
+        }
+
+        // Shift right by one; past the implicit zeros after the first try
+        int step = shifts == 0 ? 1 + shortening : 1;
+        current = ((current << step) | (current >> (cycle - step))) &
+                  cycleMask;
+        shifts += step - 1;
+    }
+
+    errorCount = -1;
+    return received;
+}
+
+int BCHDecoder::decodeCodewordPacked(const uint64_t* received,
+                                     uint64_t* corrected) {
+    return decodeCodewordPacked(received, corrected, workspace);
+}
+
+int BCHDecoder::decodeCodewordPacked(const uint64_t* received,
+                                     uint64_t* corrected,
+                                     DecodeWorkspace& workspace) const {
+    workspace.reserve(encoder);
+    if (encoder.getN() <= 64) {
+        int errorCount;
+        corrected[0] = decodeWord(received[0], errorCount, workspace);
+        return errorCount;
+    }
+
+    if (method == BCHDecodeMethod::BerlekampMassey) {
+        return decodeAlgebraic(received, corrected, workspace);
+    }
+    if (method == BCHDecodeMethod::SyndromeTable) {
+        return decodeSyndromeTable(received, corrected);
+    }
+    if (method == BCHDecodeMethod::Meggitt) {
+        return decodeMeggitt(received, corrected, workspace);
+    }
+    return decodeErrorTrapping(received, corrected, workspace);
+}
+
+int BCHDecoder::decodeErrorTrapping(const uint64_t* received,
+                                    uint64_t* corrected,
+                                    DecodeWorkspace& workspace) const {
+    int n = encoder.n;  // Cyclic shifts span 2^m - 1 bits
+    int length = encoder.getN();
+    int words = BCHEncoder::packedWords(length);
+    int shortening = encoder.shortening;
+
+    // Shortened code: the implicit zeros are only materialized here
+    uint64_t* currentVector = workspace.codeword.data();
+    uint64_t* syndrome = workspace.syndrome.data();
+    for (int w = 0; w < BCHEncoder::packedWords(n); w++) {
+        currentVector[w] = w < words ? received[w] : 0;
+    }
     int shifts = 0;
 
     // Main decoding loop
-    while (shifts <= encoder.n) {
+    while (shifts <= n) {
         // Step 1: Calculate syndrome
-        std::vector<uint8_t> syndrome = calculateSyndrome(currentVector);
+        calculateSyndrome(currentVector, shifts == 0 ? length : n, syndrome);
 
         // Step 2: Calculate Hamming weight of syndrome
-        int weight = hammingWeight(syndrome);
+        int weight = hammingWeight(syndrome, encoder.parityWords);
+
+        if (weight == 0 && shifts == 0) {
+            for (int w = 0; w < words; w++) {
+                corrected[w] = received[w];
+            }
+            return 0;  // No errors
+        }
+
+        // Case 1: w(s) ≤ t - errors in parity part
+        if (weight <= encoder.t) {
+            // Correction: c_D = c_Y + s (one XOR per word)
+            for (int w = 0; w < encoder.parityWords; w++) {
+                currentVector[w] ^= syndrome[w];
+            }
 
-        // std::cout << "Shift " << shifts << ": syndrome weight = " << weight;
+            // If there were shifts, undo them (shift left)
+            cyclicShiftLeft(currentVector, shifts, workspace.rotated.data());
 
-        // Check if all syndrome bits are zero (no errors)
-        bool syndromeZero = (weight == 0);
+            // A correction that lands on an implicit zero is not valid
+            bool valid = true;
+            for (int i = length; i < n && valid; i += 64) {
+                valid = BCHEncoder::extractBits(currentVector, i,
+                                                std::min(64, n - i)) == 0;
+            }
+            if (!valid) break;
 
-        if (syndromeZero && shifts == 0) {
-            // std::cout << " - no errors" << std::endl;
-            return currentVector;  // No errors
+            for (int w = 0; w < words; w++) {
+                corrected[w] = currentVector[w];
+            }
+            return weight;
         }
 
-        // Case 1: w(s) ≤ t - errors in parity part
+        // Case 2: w(s) > t - errors in information part
+        // Shift cyclically right and try again. Errors sit below the
+        // shortened length, so shifts 1..shortening cannot trap anything
+        // that shift 0 missed: jump past them
+        if (shifts == 0 && shortening > 0) {
+            cyclicShiftLeft(currentVector, n - 1 - shortening,
+                            workspace.rotated.data());
+            shifts += 1 + shortening;
+        } else {
+            cyclicShiftRight(currentVector);
+            shifts++;
+        }
+    }
+
+    // After n shifts failed to correct - uncorrectable errors
+    for (int w = 0; w < words; w++) {
+        corrected[w] = received[w];
+    }
+    return -1;
+}
+
+int BCHDecoder::decodeMeggitt(const uint64_t* received, uint64_t* corrected,
+                              DecodeWorkspace& workspace) const {
+    // The syndrome of x^j * r(x) mod (x^n - 1) is x^j * s(x) mod g(x)
+    // because g(x) divides x^n - 1: one division, then O(n-k) per shift
+    uint64_t* syndrome = workspace.syndrome.data();
+    calculateSyndrome(received, encoder.getN(), syndrome);
+    return correctMeggitt(received, syndrome, corrected, workspace);
+}
+
+int BCHDecoder::correctMeggitt(const uint64_t* received, uint64_t* syndrome,
+                               uint64_t* corrected,
+                               DecodeWorkspace& workspace) const {
+    int n = encoder.n;  // Cyclic shifts span 2^m - 1 bits
+    int length = encoder.getN();
+    int words = BCHEncoder::packedWords(length);
+    int parityWords = encoder.parityWords;
+    int shortening = encoder.shortening;
+
+    for (int w = 0; w < words; w++) {
+        corrected[w] = received[w];
+    }
+
+    int weight = hammingWeight(syndrome, parityWords);
+    if (weight == 0) {
+        return 0;  // No errors
+    }
+
+    for (int shifts = 0; shifts < n; shifts++) {
         if (weight <= encoder.t) {
-            // std::cout << " ≤ t=" << encoder.t
-                    //   << " - correcting errors in parity part" << std::endl;
+            // Trapped: bit i of s is an error at position i - shifts, which
+            // must not be one of the implicit zeros of a shortened code
+            for (int pass = shortening > 0 ? 0 : 1; pass < 2; pass++) {
+                for (int w = 0; w < parityWords; w++) {
+                    uint64_t bits = syndrome[w];
+                    while (bits != 0) {
+                        int pos = 64 * w + __builtin_ctzll(bits) - shifts;
+                        if (pos < 0) pos += n;
+                        if (pos >= length) return -1;
+                        if (pass == 1) {
+                            corrected[pos / 64] ^= 1ULL << (pos % 64);
+                        }
+                        bits &= bits - 1;
+                    }
+                }
+            }
+            return weight;
+        }
+
+        // Shortened code: jump past shifts 1..shortening (see trapping)
+        if (shifts == 0 && shortening > 0) {
+            encoder.parityRemainder(workspace.zeros.data(), 0, shortening,
+                                    syndrome);
+            shifts += shortening;
+        }
+
+        encoder.lfsrShiftIn(syndrome, 0);  // s = s * x mod g(x)
+        weight = hammingWeight(syndrome, parityWords);
+    }
+
+    return -1;  // Never trapped: more errors than the pattern allows
+}
 
-            // Correction: c_D = c_Y + s
-            std::vector<uint8_t> corrected = currentVector;
+// ============================================================================
+// BCH DECODER IMPLEMENTATION - Berlekamp-Massey + Chien Search
+// ============================================================================
+
+int BCHDecoder::decodeAlgebraic(const uint64_t* received,
+                                uint64_t* corrected,
+                                DecodeWorkspace& workspace) const {
+    // Step 1: Binary syndrome s(x) = r(x) mod g(x)
+    uint64_t* remainder = workspace.syndrome.data();
+    calculateSyndrome(received, encoder.getN(), remainder);
+    return correctAlgebraic(received, remainder, corrected, workspace);
+}
 
-            // Add syndrome to first (n-k) bits (parity part)
-            int parityBits = encoder.n - encoder.k;
-            for (int i = 0; i < parityBits && i < (int)syndrome.size(); i++) {
-                corrected[i] = corrected[i] ^ syndrome[i];  // XOR in GF(2)
+int BCHDecoder::correctAlgebraic(const uint64_t* received,
+                                 const uint64_t* remainder,
+                                 uint64_t* corrected,
+                                 DecodeWorkspace& workspace) const {
+    int n = encoder.n;  // Field order: exponents are taken mod n
+    int t = encoder.t;
+    int length = encoder.getN();
+    int words = BCHEncoder::packedWords(length);
+    int parityWords = encoder.parityWords;
+    const GF2m& field = encoder.field;
+
+    for (int w = 0; w < words; w++) {
+        corrected[w] = received[w];
+    }
+    if (hammingWeight(remainder, parityWords) == 0) {
+        return 0;  // No errors
+    }
+
+    // Step 2: Power-sum syndromes S_j = r(alpha^j) = s(alpha^j), j = 1..2t
+    // (g(alpha^j) = 0), so only the n-k remainder bits are visited.
+    // Only odd j need the bits: S_2j = S_j^2 for binary codes
+    uint16_t* S = workspace.powerSums.data();
+    for (int j = 0; j <= 2 * t; j++) {
+        S[j] = 0;
+    }
+    for (int w = 0; w < parityWords; w++) {
+        uint64_t bits = remainder[w];
+        while (bits != 0) {
+            int i = 64 * w + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            // Exponent i*j mod n, stepping j by 2
+            int step = (2 * i) % n;
+            int exponent = i;
+            for (int j = 1; j < 2 * t; j += 2) {
+                S[j] ^= field.alpha(exponent);
+                exponent += step;
+                if (exponent >= n) exponent -= n;
             }
+        }
+    }
 
-            // If there were shifts, undo them (shift left)
-            for (int i = 0; i < shifts; i++) {
-                corrected = cyclicShiftLeft(corrected);
+    for (int j = 2; j <= 2 * t; j += 2) {
+        S[j] = field.multiply(S[j / 2], S[j / 2]);
+    }
+
+    // Step 3: Berlekamp-Massey - shortest LFSR Lambda(x) generating S
+    int size = 2 * t + 2;
+    uint16_t* lambda = workspace.locator.data();  // Error locator
+    uint16_t* prev = workspace.previous.data();   // Copy before last update
+    uint16_t* temp = workspace.saved.data();
+    for (int i = 0; i < size; i++) {
+        lambda[i] = prev[i] = 0;
+    }
+    lambda[0] = prev[0] = 1;
+    int L = 0;           // Current LFSR length
+    int gap = 1;         // Steps since last length change
+    uint16_t prevD = 1;  // Discrepancy at last length change
+
+    for (int r = 0; r < 2 * t; r++) {
+        // Discrepancy d = S_(r+1) + sum(Lambda_i * S_(r+1-i))
+        uint16_t d = S[r + 1];
+        for (int i = 1; i <= L; i++) {
+            d ^= field.multiply(lambda[i], S[r + 1 - i]);
+        }
+
+        if (d == 0) {
+            gap++;
+            continue;
+        }
+
+        // Lambda(x) -= (d / prevD) * x^gap * prev(x)
+        uint16_t scale = field.divide(d, prevD);
+        if (2 * L <= r) {
+            std::copy(lambda, lambda + size, temp);
+        }
+        if (gap < size) {
+            field.multiplyAccumulate(lambda + gap, prev, scale, size - gap);
+        }
+
+        if (2 * L <= r) {
+            L = r + 1 - L;
+            std::swap(prev, temp);
+            prevD = d;
+            gap = 1;
+        } else {
+            gap++;
+        }
+    }
+
+    if (L > t) {
+        return -1;  // More than t errors
+    }
+
+    // Step 4: Chien search - Lambda(alpha^-i) = 0 marks an error at i.
+    // Positions are evaluated a chunk at a time; a degree-L locator has at
+    // most L roots, so the search ends at the L-th. A shortened code stops
+    // at its length: a root above it is an uncorrectable word
+    const int chunk = 128;
+    uint16_t values[chunk];
+    int found = 0;
+
+    for (int first = 0; first < length && found < L; first += chunk) {
+        int count = std::min(chunk, length - first);
+        field.evaluatePowers(lambda, L, -first, -1, count, values);
+        for (int i = 0; i < count; i++) {
+            if (values[i] == 0) {
+                int pos = first + i;
+                corrected[pos / 64] ^= 1ULL << (pos % 64);
+                found++;
             }
+        }
+    }
 
-            errorCount = weight;
+    // Lambda must split into L distinct roots inside the code
+    if (found != L) {
+        for (int w = 0; w < words; w++) {
+            corrected[w] = received[w];
+        }
+        return -1;
+    }
+
+    return L;
+}
+
+// ============================================================================
+// BCH DECODER IMPLEMENTATION - Syndrome Table (Coset Leaders)
+// ============================================================================
+
+bool BCHDecoder::buildSyndromeTable() {
+    int n = encoder.getN();  // Shortened codes: errors only below n
+    int t = encoder.t;
+    int parityBits = n - encoder.getK();
+
+    if (parityBits > 16) {
+        std::cerr << "Syndrome table needs n-k <= 16, got " << parityBits
+                  << " - using error trapping" << std::endl;
+        return false;
+    }
+
+    size_t entries = (size_t)1 << parityBits;
+    syndromeWeight.assign(entries, -1);
+    syndromeWeight[0] = 0;
+    if (n <= 64) {
+        syndromePattern.assign(entries, 0);
+        syndromePositions.clear();
+    } else {
+        syndromePositions.assign(entries * t, 0);
+        syndromePattern.clear();
+    }
+
+    // Syndrome of a single error at position i: x^i mod g(x)
+    uint32_t generator = 0;
+    for (int i = 0; i <= parityBits; i++) {
+        if (encoder.generatorPoly[i] != 0) generator |= 1u << i;
+    }
+
+    std::vector<uint32_t> column(n);
+    uint32_t value = 1;
+    for (int i = 0; i < n; i++) {
+        column[i] = value;
+        value <<= 1;
+        if ((value >> parityBits) & 1) value ^= generator;
+    }
 
-            // std::cout << "Corrected " << errorCount << " error(s)" << std::endl;
-            return corrected;
+    // Enumerate error patterns by increasing weight, so the first pattern
+    // stored for a syndrome is its coset leader
+    std::vector<int> pos(t);
+    for (int weight = 1; weight <= t && weight <= n; weight++) {
+        for (int i = 0; i < weight; i++) {
+            pos[i] = i;
         }
 
-        // Case 2: w(s) > t - errors in information part
-        // Shift cyclically right and try again
-        // std::cout << " > t=" << encoder.t << " - shifting cyclically right"
-                //   << std::endl;
+        while (true) {
+            uint32_t syndrome = 0;
+            for (int i = 0; i < weight; i++) {
+                syndrome ^= column[pos[i]];
+            }
+
+            if (syndromeWeight[syndrome] < 0) {
+                syndromeWeight[syndrome] = weight;
+                for (int i = 0; i < weight; i++) {
+                    if (n <= 64) {
+                        syndromePattern[syndrome] |= 1ULL << pos[i];
+                    } else {
+                        syndromePositions[syndrome * t + i] = pos[i];
+                    }
+                }
+            }
 
-        currentVector = cyclicShiftRight(currentVector);
-        shifts++;
+            // Next combination in lexicographic order
+            int i = weight - 1;
+            while (i >= 0 && pos[i] == n - weight + i) i--;
+            if (i < 0) break;
+            pos[i]++;
+            for (int j = i + 1; j < weight; j++) {
+                pos[j] = pos[j - 1] + 1;
+            }
+        }
     }
 
-    // After n shifts failed to correct - uncorrectable errors
-    // std::cerr << "ERROR: Failed to correct after " << shifts
-            //   << " shifts - uncorrectable errors!" << std::endl;
-    errorCount = -1;
-    return received;  // Return unchanged vector
+    return true;
+}
+
+int BCHDecoder::decodeSyndromeTable(const uint64_t* received,
+                                    uint64_t* corrected) const {
+    uint64_t syndrome = 0;  // n-k <= 16 bits, one word
+    calculateSyndrome(received, encoder.getN(), &syndrome);
+    return correctSyndromeTable(received, syndrome, corrected);
+}
+
+int BCHDecoder::correctSyndromeTable(const uint64_t* received,
+                                     uint64_t syndrome,
+                                     uint64_t* corrected) const {
+    int n = encoder.getN();
+    int words = BCHEncoder::packedWords(n);
+    for (int w = 0; w < words; w++) {
+        corrected[w] = received[w];
+    }
+
+    int weight = syndromeWeight[syndrome];
+    if (n <= 64) {
+        if (weight > 0) corrected[0] ^= syndromePattern[syndrome];
+        return weight;
+    }
+
+    const uint16_t* positions = &syndromePositions[syndrome * encoder.t];
+    for (int i = 0; i < weight; i++) {
+        corrected[positions[i] / 64] ^= 1ULL << (positions[i] % 64);
+    }
+    return weight;
+}
+
+// ============================================================================
+// BCH DECODER IMPLEMENTATION - Chase-II Soft Decision
+// ============================================================================
+
+int BCHDecoder::decodeSoft(const std::vector<float>& llr, int flips,
+                           std::vector<uint8_t>& correctedMessage) {
+    if ((int)llr.size() != encoder.getN()) {
+        std::cerr << "Error: Expected " << encoder.getN() << " LLRs, got "
+                  << llr.size() << std::endl;
+        return -1;
+    }
+
+    std::vector<uint64_t> message(BCHEncoder::packedWords(encoder.getK()));
+    int changed = decodeSoft(llr.data(), flips, message.data());
+    if (changed >= 0) {
+        correctedMessage = BCHEncoder::unpackBits(message.data(),
+                                                  encoder.getK());
+    }
+    return changed;
+}
+
+int BCHDecoder::decodeSoft(const float* llr, int flips,
+                           uint64_t* correctedMessage) {
+    return decodeSoft(llr, flips, correctedMessage, workspace);
+}
+
+int BCHDecoder::decodeSoft(const float* llr, int flips,
+                           uint64_t* correctedMessage,
+                           DecodeWorkspace& workspace) const {
+    workspace.reserve(encoder);
+    uint64_t* corrected = workspace.corrected.data();
+    int changed = decodeSoftCodeword(llr, flips, corrected, workspace);
+    if (changed < 0) {
+        return -1;  // Decoding failed
+    }
+
+    int parityBits = encoder.n - encoder.k;
+    for (int i = 0; i < encoder.getK(); i += 64) {
+        int len = std::min(64, encoder.getK() - i);
+        correctedMessage[i / 64] =
+            BCHEncoder::extractBits(corrected, parityBits + i, len);
+    }
+    return changed;
+}
+
+int BCHDecoder::decodeSoftCodeword(const float* llr, int flips,
+                                   uint64_t* corrected,
+                                   DecodeWorkspace& workspace) const {
+    int length = encoder.getN();
+    int words = BCHEncoder::packedWords(length);
+    int parityWords = encoder.parityWords;
+    if (flips < 0 || flips > maxSoftFlips || flips > length) {
+        std::cerr << "Error: Chase decoding flips 0.." << maxSoftFlips
+                  << " positions, got " << flips << std::endl;
+        return -1;
+    }
+    workspace.reserve(encoder);
+
+    uint64_t* hard = workspace.softWords.data();
+    uint64_t* test = hard + words;
+    uint64_t* candidate = test + words;
+    uint64_t* syndrome = workspace.softSyndromes.data();  // Of test
+    uint64_t* scratch = syndrome + parityWords;
+    uint64_t* unitSyndromes = scratch + parityWords;      // x^pos mod g(x)
+
+    // Hard decisions and the least reliable positions, kept sorted by
+    // |LLR| in a list of at most `flips` entries
+    int positions[maxSoftFlips];
+    int listed = 0;
+    for (int w = 0; w < words; w++) {
+        hard[w] = 0;
+    }
+    for (int i = 0; i < length; i++) {
+        if (llr[i] < 0) hard[i / 64] |= 1ULL << (i % 64);
+
+        float reliability = std::fabs(llr[i]);
+        if (flips == 0) continue;
+        if (listed == flips &&
+            reliability >= std::fabs(llr[positions[listed - 1]])) {
+            continue;
+        }
+        int slot = listed < flips ? listed++ : listed - 1;
+        while (slot > 0 && std::fabs(llr[positions[slot - 1]]) > reliability) {
+            positions[slot] = positions[slot - 1];
+            slot--;
+        }
+        positions[slot] = i;
+    }
+
+    // A hard decision that is a codeword is at distance 0: nothing beats it
+    calculateSyndrome(hard, length, syndrome);
+    if (hammingWeight(syndrome, parityWords) == 0) {
+        for (int w = 0; w < words; w++) {
+            corrected[w] = hard[w];
+        }
+        return 0;
+    }
+
+    // The syndrome is linear: flipping bit pos adds x^pos mod g(x)
+    for (int w = 0; w < words; w++) {
+        test[w] = 0;
+    }
+    for (int b = 0; b < flips; b++) {
+        int pos = positions[b];
+        test[pos / 64] = 1ULL << (pos % 64);
+        calculateSyndrome(test, length, &unitSyndromes[b * parityWords]);
+        test[pos / 64] = 0;
+    }
+    for (int w = 0; w < words; w++) {
+        test[w] = hard[w];
+    }
+
+    float bestMetric = 0;
+    int bestChanged = -1;
+    for (uint32_t pattern = 0; pattern < (1u << flips); pattern++) {
+        if (pattern > 0) {
+            // Gray code: the next pattern differs in one position
+            int b = __builtin_ctz(pattern);
+            test[positions[b] / 64] ^= 1ULL << (positions[b] % 64);
+            for (int w = 0; w < parityWords; w++) {
+                syndrome[w] ^= unitSyndromes[b * parityWords + w];
+            }
+        }
+
+        int errors;
+        if (method == BCHDecodeMethod::BerlekampMassey) {
+            errors = correctAlgebraic(test, syndrome, candidate, workspace);
+        } else if (method == BCHDecodeMethod::SyndromeTable) {
+            errors = correctSyndromeTable(test, syndrome[0], candidate);
+        } else {
+            std::copy(syndrome, syndrome + parityWords, scratch);
+            errors = correctMeggitt(test, scratch, candidate, workspace);
+        }
+        if (errors < 0) continue;
+
+        // Squared Euclidean distance of BPSK signals, up to a constant and
+        // a scale: the |LLR| of every bit the candidate changes
+        float metric = 0;
+        int changed = 0;
+        for (int w = 0; w < words; w++) {
+            uint64_t diff = candidate[w] ^ hard[w];
+            while (diff != 0) {
+                metric += std::fabs(llr[64 * w + __builtin_ctzll(diff)]);
+                changed++;
+                diff &= diff - 1;
+            }
+        }
+
+        if (bestChanged < 0 || metric < bestMetric) {
+            bestMetric = metric;
+            bestChanged = changed;
+            for (int w = 0; w < words; w++) {
+                corrected[w] = candidate[w];
+            }
+        }
+    }
+
+    return bestChanged;
+}
+
+// ============================================================================
+// BCH DECODER IMPLEMENTATION - Bit-Sliced Batches
+// ============================================================================
+
+uint64_t BCHDecoder::syndromeBatch(const uint64_t* receivedSlices) {
+    return syndromeBatch(receivedSlices, workspace);
+}
+
+uint64_t BCHDecoder::syndromeBatch(const uint64_t* receivedSlices,
+                                   DecodeWorkspace& workspace) const {
+    int parityBits = encoder.n - encoder.k;
+    workspace.reserve(encoder);
+
+    // s(x) = (message part * x^(n-k) mod g(x)) + parity part
+    uint64_t* remainder = workspace.sliceSyndrome.data();
+    encoder.batchRemainder(receivedSlices + parityBits, remainder,
+                           workspace.row.data());
+
+    uint64_t dirty = 0;
+    for (int j = 0; j < parityBits; j++) {
+        dirty |= remainder[j] ^ receivedSlices[j];
+    }
+    return dirty;
+}
+
+uint64_t BCHDecoder::decodeBatchPacked(const uint64_t* received,
+                                       uint64_t* correctedMessages,
+                                       int* errorCounts) {
+    return decodeBatchPacked(received, correctedMessages, errorCounts,
+                             workspace);
+}
+
+uint64_t BCHDecoder::decodeBatchPacked(const uint64_t* received,
+                                       uint64_t* correctedMessages,
+                                       int* errorCounts,
+                                       DecodeWorkspace& workspace) const {
+    int n = encoder.getN();
+    int parityBits = n - encoder.getK();
+    int words = BCHEncoder::packedWords(n);
+    int messageWords = BCHEncoder::packedWords(encoder.getK());
+    workspace.reserve(encoder);
+
+    uint64_t* slices = workspace.slices.data();
+    BCHEncoder::toBitSlices(received, n, slices);
+    uint64_t dirty = syndromeBatch(slices, workspace);
+
+    // Every lane gets its received message bits; clean lanes are done
+    BCHEncoder::fromBitSlices(slices + parityBits, encoder.getK(),
+                              correctedMessages);
+
+    for (int lane = 0; lane < BCHEncoder::batchLanes; lane++) {
+        errorCounts[lane] = 0;
+        if ((dirty >> lane) & 1) {
+            errorCounts[lane] =
+                decodePacked(&received[lane * words],
+                             &correctedMessages[lane * messageWords],
+                             workspace);
+        }
+    }
+    return dirty;
+}
+
+// ============================================================================
+// BCH DECODER IMPLEMENTATION - Descriptor Import/Export
+// ============================================================================
+
+std::vector<uint8_t> BCHDecoder::exportDescriptor() const {
+    std::vector<uint8_t> out = encoder.exportDescriptor();
+    if (out.empty()) return out;
+
+    size_t section = beginSection(out, TagDecoder);
+    appendU32(out, (uint32_t)method);
+    if (method == BCHDecodeMethod::SyndromeTable) {
+        appendU32(out, syndromeWeight.size());
+        appendBytes(out, syndromeWeight.data(), syndromeWeight.size());
+        appendBytes(out, syndromePattern.data(),
+                    syndromePattern.size() * sizeof(uint64_t));
+        appendBytes(out, syndromePositions.data(),
+                    syndromePositions.size() * sizeof(uint16_t));
+    }
+    endSection(out, section);
+    return out;
+}
+
+bool BCHDecoder::loadDescriptor(const uint8_t* data, size_t size) {
+    // The decoder section is only valid for the code it was exported with
+    SectionReader reader;
+    uint32_t code[6];
+    if (!findSection(data, size, TagCode, reader) ||
+        !reader.read(code, sizeof(code)) || code[0] != (uint32_t)encoder.m ||
+        code[1] != (uint32_t)encoder.t ||
+        code[2] != encoder.primitivePoly || code[4] != (uint32_t)encoder.k) {
+        std::cerr << "Descriptor does not match the encoder" << std::endl;
+        return false;
+    }
+
+    // The syndrome table only covers the shortened length
+    uint32_t shortening = 0;
+    if (findSection(data, size, TagShortening, reader) &&
+        !reader.read(&shortening, sizeof(shortening))) {
+        shortening = ~0u;
+    }
+    if (shortening != (uint32_t)encoder.shortening) {
+        std::cerr << "Descriptor shortening does not match the encoder"
+                  << std::endl;
+        return false;
+    }
+
+    uint32_t loadedMethod = 0;
+    if (!findSection(data, size, TagDecoder, reader) ||
+        !reader.read(&loadedMethod, sizeof(loadedMethod)) ||
+        loadedMethod > (uint32_t)BCHDecodeMethod::Meggitt) {
+        std::cerr << "No decoder section in descriptor" << std::endl;
+        return false;
+    }
+
+    if (loadedMethod == (uint32_t)BCHDecodeMethod::SyndromeTable) {
+        int parityBits = encoder.n - encoder.k;
+        uint32_t entries = 0;
+        if (parityBits > 16 || !reader.read(&entries, sizeof(entries)) ||
+            entries != (uint32_t)1 << parityBits) {
+            std::cerr << "Invalid syndrome table in descriptor" << std::endl;
+            return false;
+        }
+
+        std::vector<int8_t> weights(entries);
+        std::vector<uint64_t> patterns(encoder.getN() <= 64 ? entries : 0);
+        std::vector<uint16_t> positions(
+            encoder.getN() <= 64 ? 0 : (size_t)entries * encoder.t);
+        if (!reader.read(weights.data(), weights.size()) ||
+            !reader.read(patterns.data(),
+                         patterns.size() * sizeof(uint64_t)) ||
+            !reader.read(positions.data(),
+                         positions.size() * sizeof(uint16_t))) {
+            std::cerr << "Truncated syndrome table in descriptor"
+                      << std::endl;
+            return false;
+        }
+
+        // The correction flips the stored positions, so a damaged table
+        // must not get past this point: weights -1 (uncorrectable) to t,
+        // no error outside the n bits of the codeword
+        int n = encoder.getN();
+        int t = encoder.t;
+        bool invalid = false;
+        for (uint32_t s = 0; s < entries; s++) {
+            invalid |= (weights[s] < -1) | (weights[s] > t);
+        }
+        uint64_t outside = n < 64 ? ~0ULL << n : 0;
+        for (uint64_t pattern : patterns) {
+            invalid |= (pattern & outside) != 0;
+        }
+        for (size_t s = 0; s < positions.size() / t; s++) {
+            // Only the first weight positions of an entry are used
+            const uint16_t* entry = &positions[s * t];
+            int weight = weights[s];
+            for (int i = 0; i < t; i++) {
+                invalid |= (i < weight) & (entry[i] >= n);
+            }
+        }
+        if (invalid) {
+            std::cerr << "Invalid syndrome table entry in descriptor"
+                      << std::endl;
+            return false;
+        }
+        syndromeWeight.swap(weights);
+        syndromePattern.swap(patterns);
+        syndromePositions.swap(positions);
+    }
+
+    method = (BCHDecodeMethod)loadedMethod;
+    return true;
 }
@@ -1,12 +1,34 @@
 #ifndef BCH_HPP
 #define BCH_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "gf2m.hpp"
+
+/**
+ * Parity computation strategy used by BCHEncoder::encode
+ */
+enum class BCHEncodeMode {
+    BitSerial,  // Long division by g(x), one message bit per step
+    Table8,     // Precomputed remainder table, 8 message bits per step
+    Table16     // Precomputed remainder table, 16 message bits per step
+};
+
+/**
+ * Error correction algorithm used by BCHDecoder
+ */
+enum class BCHDecodeMethod {
+    ErrorTrapping,    // Cyclic shifts until the syndrome weight is <= t
+    BerlekampMassey,  // Power-sum syndromes, Berlekamp-Massey, Chien search
+    SyndromeTable,    // Coset-leader lookup, needs n - k <= 16
+    Meggitt           // Error trapping with one syndrome, shifted by x
+};
+
 /**
  * BCH (Bose-Chaudhuri-Hocquenghem) Encoder for GF(2^m)
  * Implements systematic encoding using cyclotomic cosets
@@ -15,18 +37,31 @@ class BCHEncoder {
    public:
     /**
      * Constructor for BCH encoder
-     * @param m Extension degree of Galois Field GF(2^m)
+     * @param m Extension degree of Galois Field GF(2^m), 2..16
      * @param t Error correction capability (number of errors to correct)
      * @param primitivePoly Primitive polynomial for GF(2^m) construction
+     *                      (bit i = coefficient of x^i, 0 = built-in)
      */
-    BCHEncoder(int m, int t, uint16_t primitivePoly = 0);
+    BCHEncoder(int m, int t, uint32_t primitivePoly = 0);
 
     /**
      * Initialize the BCH encoder with specific parameters
-     * @return true if initialization successful
+     * @return true if initialization successful, false for an unsupported
+     *         m or a polynomial that is not primitive
      */
     bool initialize();
 
+    /**
+     * Shorten the code to carry messages of k' < k bits. The k - k' leading
+     * message bits are implicit zeros: they are not stored, transmitted or
+     * visited by the decoder, so codewords have n' = n - (k - k') bits.
+     * getN() and getK() return the shortened sizes. Call after initialize()
+     * and before creating decoders; initialize() resets to the full code.
+     * @param messageLength Message bits k', 1..k (k restores the full code)
+     * @return true if messageLength is in range
+     */
+    bool setMessageLength(int messageLength);
+
     /**
      * Encode a message using systematic BCH encoding
      * @param message Input message bits (k bits)
@@ -34,71 +69,242 @@ class BCHEncoder {
      */
     std::vector<uint8_t> encode(const std::vector<uint8_t>& message);
 
-    // Getters for code parameters
-    int getN() const { return n; }  // Code length
-    int getK() const { return k; }  // Message length
+    /**
+     * Encode a bit-packed message (requires n <= 64)
+     * Packed layout: bit i holds element i of the vector API, so the
+     * codeword is parity in bits 0..n-k-1 and the message above it
+     * @param message Message bits (k bits, bit i = message[i])
+     * @return Packed codeword (n bits)
+     */
+    uint64_t encodePacked(uint64_t message) const;
+
+    /**
+     * Encode a bit-packed message of any length
+     * @param message Input: packedWords(k) words
+     * @param codeword Output: packedWords(n) words
+     */
+    void encodePacked(const uint64_t* message, uint64_t* codeword) const;
+
+    /**
+     * Encode 64 messages at once in bit-sliced form: slice i holds bit i of
+     * every message, lane j in bit j of the word
+     * @param messageSlices Input: k slices (may alias codewordSlices + n-k)
+     * @param codewordSlices Output: n slices
+     */
+    void encodeBatch(const uint64_t* messageSlices,
+                     uint64_t* codewordSlices) const;
+
+    /**
+     * encodeBatch() with caller-supplied scratch, so it does not touch the
+     * heap
+     * @param messageSlices Input: k slices (may alias codewordSlices + n-k)
+     * @param codewordSlices Output: n slices
+     * @param scratch packedWords(n-k) words
+     */
+    void encodeBatch(const uint64_t* messageSlices, uint64_t* codewordSlices,
+                     uint64_t* scratch) const;
+
+    /**
+     * Encode 64 packed messages through the bit-sliced encoder
+     * @param messages Input: 64 * packedWords(k) words, lane after lane
+     * @param codewords Output: 64 * packedWords(n) words, lane after lane
+     */
+    void encodeBatchPacked(const uint64_t* messages,
+                           uint64_t* codewords) const;
+
+    /**
+     * Select how encode() computes parity bits. Table modes build their
+     * remainder table on first use (2 KiB per 64 parity bits for Table8,
+     * 512 KiB for Table16). All modes produce identical codewords.
+     * @param mode Encoding strategy
+     */
+    void setEncodeMode(BCHEncodeMode mode);
+    BCHEncodeMode getEncodeMode() const { return encodeMode; }
+
+    /**
+     * Serialize the initialized code: parameters, g(x) and the remainder
+     * table of the current encode mode
+     * @return Descriptor bytes (host byte order, little-endian)
+     */
+    std::vector<uint8_t> exportDescriptor() const;
+
+    /**
+     * Initialize from a descriptor written by exportDescriptor() instead of
+     * computing g(x) (alternative to initialize()). The field tables are
+     * rebuilt from m and the primitive polynomial; the other tables are
+     * copied, so data may point into an mmap'd file.
+     * @param data Descriptor bytes
+     * @param size Descriptor length in bytes
+     * @return true if the descriptor is valid and describes the m, t and
+     *         primitive polynomial given to the constructor
+     */
+    bool loadDescriptor(const uint8_t* data, size_t size);
+
+    // Getters for code parameters (shortened sizes, see setMessageLength)
+    int getN() const { return n - shortening; }  // Code length
+    int getK() const { return k - shortening; }  // Message length
+    int getShortening() const { return shortening; }  // Implicit zeros
     int getT() const { return t; }  // Error correction capability
     int getM() const { return m; }  // GF extension degree
 
+    // Field arithmetic shared with the decoders (valid after initialize())
+    const GF2m& getField() const { return field; }
+
+    // Backend of the field's bulk operations (e.g. GF2mBackend::ZechLog)
+    bool setFieldBackend(GF2mBackend backend) {
+        return field.setBackend(backend);
+    }
+
     // Get generator polynomial
     std::vector<uint8_t> getGeneratorPolynomial() const {
-        return generatorPoly;
+        return std::vector<uint8_t>(generatorPoly.begin(),
+                                    generatorPoly.end());
     }
 
     // Print code information
     void printCodeInfo() const;
 
+    // Packed bit vector helpers (bit i lives in word i / 64)
+    static int packedWords(int bits) { return (bits + 63) / 64; }
+    static void packBits(const std::vector<uint8_t>& bits, uint64_t* words);
+    static std::vector<uint8_t> unpackBits(const uint64_t* words, int count);
+
+    // Read len (1..64) bits starting at bit pos of a packed array
+    static uint64_t extractBits(const uint64_t* words, int pos, int len) {
+        int word = pos / 64;
+        int offset = pos % 64;
+        uint64_t value = words[word] >> offset;
+        if (offset + len > 64) {
+            value |= words[word + 1] << (64 - offset);
+        }
+        if (len < 64) value &= (1ULL << len) - 1;
+        return value;
+    }
+
+    // Write len (1..64) bits of value at bit pos (destination bits must be
+    // clear)
+    static void depositBits(uint64_t* words, int pos, int len,
+                            uint64_t value) {
+        int word = pos / 64;
+        int offset = pos % 64;
+        words[word] |= value << offset;
+        if (offset + len > 64) {
+            words[word + 1] |= value >> (64 - offset);
+        }
+    }
+
+    // Bit-sliced batches: 64 packed vectors of `bits` bits (lane after lane)
+    // to `bits` slices and back
+    static const int batchLanes = 64;
+    static void toBitSlices(const uint64_t* words, int bits, uint64_t* slices);
+    static void fromBitSlices(const uint64_t* slices, int bits,
+                              uint64_t* words);
+
    private:
     // GF(2^m) parameters
     int m;                   // Extension degree
     int t;                   // Error correction capability
-    uint16_t primitivePoly;  // Primitive polynomial
-    int n;                   // Code length (2^m - 1)
-    int k;                   // Message length (n - degree of g(x))
+    uint32_t primitivePoly;  // Primitive polynomial (m + 1 bits)
+    int n;                   // Full code length (2^m - 1)
+    int k;                   // Full message length (n - degree of g(x))
+    int shortening;          // Implicit leading zero message bits
+
+    GF2m field;  // GF(2^m) arithmetic
 
-    // GF arithmetic tables
-    std::vector<uint16_t> alphaToInt;  // α^i to integer representation
-    std::vector<int> intToAlpha;       // Integer to α^i (log table)
+    // Polynomials (GF(2^m) coefficients during construction)
+    std::vector<uint16_t> generatorPoly;  // Generator polynomial g(x)
 
-    // Polynomials
-    std::vector<uint8_t> generatorPoly;  // Generator polynomial g(x)
+    // Table-driven (CRC style) parity register
+    BCHEncodeMode encodeMode;
+    int tableBits;    // Message bits consumed per table step
+    int parityWords;  // 64-bit words holding the (n-k)-bit register
+    std::vector<uint64_t> generatorLow;    // g(x) + x^(n-k), packed
+    std::vector<uint64_t> remainderTable;  // x^(n-k) * i(x) mod g(x)
 
-    // Helper functions for GF(2^m) arithmetic
-    void buildGaloisField();
-    uint16_t gfMultiply(uint16_t a, uint16_t b);
-    uint16_t gfAdd(uint16_t a, uint16_t b);
-    // uint16_t gfPower(uint16_t alpha, int power);
+    void buildRemainderTable();
+    void lfsrShiftIn(uint64_t* reg, int bit) const;
+
+    // reg = (reg * x^count + bits[offset, offset+count) * x^(n-k)) mod g(x)
+    void parityRemainder(const uint64_t* bits, int offset, int count,
+                         uint64_t* reg) const;
+
+    // Bit-sliced x^(n-k) * bits(x) mod g(x) for 64 lanes (k input slices);
+    // row is parityWords words of scratch
+    void batchRemainder(const uint64_t* slices, uint64_t* remainder,
+                        uint64_t* row) const;
 
     // Cyclotomic coset generation
     std::vector<std::set<int>> generateCyclotomicCosets();
 
     // Minimal polynomial computation
-    std::vector<uint8_t> computeMinimalPolynomial(const std::set<int>& coset);
+    std::vector<uint16_t> computeMinimalPolynomial(const std::set<int>& coset);
 
     // Polynomial operations
-    std::vector<uint8_t> polyMultiply(const std::vector<uint8_t>& a,
-                                      const std::vector<uint8_t>& b);
-    std::vector<uint8_t> polyDivide(const std::vector<uint8_t>& dividend,
-                                    const std::vector<uint8_t>& divisor,
-                                    std::vector<uint8_t>& remainder);
-    std::vector<uint8_t> polyLCM(const std::vector<uint8_t>& a,
-                                 const std::vector<uint8_t>& b);
-    std::vector<uint8_t> polyGCD(const std::vector<uint8_t>& a,
-                                 const std::vector<uint8_t>& b);
-    int polyDegree(const std::vector<uint8_t>& poly) const;
+    std::vector<uint16_t> polyMultiply(const std::vector<uint16_t>& a,
+                                       const std::vector<uint16_t>& b);
+    std::vector<uint16_t> polyDivide(const std::vector<uint16_t>& dividend,
+                                     const std::vector<uint16_t>& divisor,
+                                     std::vector<uint16_t>& remainder);
+    std::vector<uint16_t> polyLCM(const std::vector<uint16_t>& a,
+                                  const std::vector<uint16_t>& b);
+    std::vector<uint16_t> polyGCD(const std::vector<uint16_t>& a,
+                                  const std::vector<uint16_t>& b);
+    int polyDegree(const std::vector<uint16_t>& poly) const;
 
     // Generator polynomial construction
     void generateGeneratorPolynomial();
 
-    // Default primitive polynomials for different m values
-    static uint16_t getDefaultPrimitivePoly(int m);
-
     // Allow decoder to access private members
     friend class BCHDecoder;
 };
 
 /**
- * BCH Decoder - Hamming weight based decoding with cyclic shifts
+ * Scratch buffers for BCHDecoder. The buffers grow to the largest code
+ * they were used with and are then reused, so decoding through a workspace
+ * does not touch the heap after the first call. A workspace is not
+ * thread-safe: use one per thread.
+ */
+class DecodeWorkspace {
+   public:
+    DecodeWorkspace() {}
+
+    /**
+     * Preallocate for a code, so even the first decode does not allocate
+     * @param encoder Initialized encoder of the code
+     */
+    explicit DecodeWorkspace(const BCHEncoder& encoder) { reserve(encoder); }
+
+    /**
+     * Grow the buffers to fit a code (never shrinks them)
+     * @param encoder Initialized encoder of the code
+     */
+    void reserve(const BCHEncoder& encoder);
+
+   private:
+    std::vector<uint64_t> codeword;         // Shifted word, 2^m - 1 bits
+    std::vector<uint64_t> rotated;          // Cyclic shift target, 2^m - 1 bits
+    std::vector<uint64_t> zeros;            // Never written, 2^m - 1 bits
+    std::vector<uint64_t> corrected;        // Corrected codeword, n bits
+    std::vector<uint64_t> syndrome;         // s(x), n-k bits
+    std::vector<uint64_t> row;              // Remainder row, n-k bits
+    std::vector<uint64_t> slices;           // Bit-sliced batch, n slices
+    std::vector<uint64_t> sliceSyndrome;    // Batch syndrome, n-k slices
+    std::vector<uint16_t> powerSums;        // S_1..S_2t
+    std::vector<uint16_t> locator;          // Lambda(x)
+    std::vector<uint16_t> previous;         // Lambda at the last length change
+    std::vector<uint16_t> saved;            // Lambda before the current update
+    std::vector<uint64_t> softWords;        // Hard decision, test, candidate
+    std::vector<uint64_t> softSyndromes;    // Test, scratch, one per flip
+
+    static void grow(std::vector<uint64_t>& buffer, size_t size);
+    static void grow(std::vector<uint16_t>& buffer, size_t size);
+
+    friend class BCHDecoder;
+};
+
+/**
+ * BCH Decoder - Hamming weight based decoding with cyclic shifts, or
+ * algebraic decoding (Berlekamp-Massey + Chien search)
  * Works with BCHEncoder to decode and correct errors
  */
 class BCHDecoder {
@@ -106,8 +312,20 @@ class BCHDecoder {
     /**
      * Constructor - uses same parameters as encoder
      * @param encoder Reference to initialized BCH encoder
+     * @param method Error correction algorithm for this decoder
      */
-    BCHDecoder(BCHEncoder& encoder);
+    BCHDecoder(BCHEncoder& encoder,
+               BCHDecodeMethod method = BCHDecodeMethod::ErrorTrapping);
+
+    /**
+     * Select the error correction algorithm. SyndromeTable builds a
+     * 2^(n-k) entry coset-leader table from g(x) and falls back to
+     * ErrorTrapping if n - k > 16. Meggitt corrects the same patterns as
+     * ErrorTrapping with a single division; pair it with a table encode
+     * mode so that division is table-driven.
+     */
+    void setMethod(BCHDecodeMethod method);
+    BCHDecodeMethod getMethod() const { return method; }
 
     /**
      * Decode a received codeword and correct errors
@@ -127,21 +345,186 @@ class BCHDecoder {
     std::vector<uint8_t> decodeCodeword(const std::vector<uint8_t>& received,
                                         int& errorCount);
 
+    /**
+     * Decode a bit-packed codeword (requires n <= 64)
+     * @param received Received codeword (n bits, layout as encodePacked)
+     * @param correctedMessage Output: corrected message (k bits)
+     * @return Number of errors corrected (-1 if uncorrectable)
+     */
+    int decodePacked(uint64_t received, uint64_t& correctedMessage);
+
+    /**
+     * Decode a bit-packed codeword of any length
+     * @param received Input: packedWords(n) words
+     * @param correctedMessage Output: packedWords(k) words
+     * @return Number of errors corrected (-1 if uncorrectable)
+     */
+    int decodePacked(const uint64_t* received, uint64_t* correctedMessage);
+
+    /**
+     * Decode a bit-packed codeword into caller buffers without allocating
+     * once the workspace has grown to this code. Const, so several threads
+     * may share one decoder as long as each passes its own workspace.
+     * @param received Input: packedWords(n) words
+     * @param correctedMessage Output: packedWords(k) words
+     * @param workspace Scratch buffers of the calling thread
+     * @return Number of errors corrected (-1 if uncorrectable)
+     */
+    int decodePacked(const uint64_t* received, uint64_t* correctedMessage,
+                     DecodeWorkspace& workspace) const;
+
+    /**
+     * Correct a bit-packed codeword (requires n <= 64)
+     * @param received Received codeword (n bits)
+     * @param errorCount Output: number of errors corrected (-1 if failed)
+     * @return Corrected codeword (received unchanged on failure)
+     */
+    uint64_t decodeCodewordPacked(uint64_t received, int& errorCount);
+
+    /**
+     * Correct a bit-packed codeword of any length
+     * @param received Input: packedWords(n) words
+     * @param corrected Output: packedWords(n) words
+     * @return Number of errors corrected (-1 if uncorrectable)
+     */
+    int decodeCodewordPacked(const uint64_t* received, uint64_t* corrected);
+
+    /**
+     * Correct a bit-packed codeword using caller scratch buffers
+     * @param received Input: packedWords(n) words
+     * @param corrected Output: packedWords(n) words
+     * @param workspace Scratch buffers of the calling thread
+     * @return Number of errors corrected (-1 if uncorrectable)
+     */
+    int decodeCodewordPacked(const uint64_t* received, uint64_t* corrected,
+                             DecodeWorkspace& workspace) const;
+
+    /**
+     * Bit-sliced syndrome check of 64 received words
+     * @param receivedSlices Input: n slices (layout as encodeBatch)
+     * @return Mask of lanes with a nonzero syndrome
+     */
+    uint64_t syndromeBatch(const uint64_t* receivedSlices);
+    uint64_t syndromeBatch(const uint64_t* receivedSlices,
+                           DecodeWorkspace& workspace) const;
+
+    /**
+     * Decode 64 packed codewords. Clean words are filtered out in bulk by
+     * syndromeBatch(); only the remaining lanes are decoded one by one.
+     * @param received Input: 64 * packedWords(n) words, lane after lane
+     * @param correctedMessages Output: 64 * packedWords(k) words
+     * @param errorCounts Output: 64 error counts (-1 if uncorrectable)
+     * @return Mask of lanes that needed per-word decoding
+     */
+    uint64_t decodeBatchPacked(const uint64_t* received,
+                               uint64_t* correctedMessages, int* errorCounts);
+    uint64_t decodeBatchPacked(const uint64_t* received,
+                               uint64_t* correctedMessages, int* errorCounts,
+                               DecodeWorkspace& workspace) const;
+
+    /**
+     * Chase-II soft-decision decoding. The `flips` least reliable bits are
+     * flipped in all 2^flips combinations and every test pattern goes
+     * through this decoder's method (ErrorTrapping runs as Meggitt, which
+     * corrects the same patterns). The patterns are visited in Gray-code
+     * order: each costs one syndrome update instead of a division. The
+     * winner is the candidate codeword closest in Euclidean distance, i.e.
+     * with the least sum of |LLR| over the bits it changes.
+     * @param llr n log-likelihood ratios log(P(0) / P(1)) (negative = 1)
+     * @param flips Least reliable positions to flip, 0..maxSoftFlips
+     * @param correctedMessage Output: packedWords(k) words
+     * @return Bits changed against the hard decisions (-1 if no test
+     *         pattern decodes)
+     */
+    static const int maxSoftFlips = 16;
+    int decodeSoft(const float* llr, int flips, uint64_t* correctedMessage);
+    int decodeSoft(const float* llr, int flips, uint64_t* correctedMessage,
+                   DecodeWorkspace& workspace) const;
+    int decodeSoft(const std::vector<float>& llr, int flips,
+                   std::vector<uint8_t>& correctedMessage);
+
+    /**
+     * Chase-II decoding to the full codeword
+     * @param llr n log-likelihood ratios (negative = 1)
+     * @param flips Least reliable positions to flip, 0..maxSoftFlips
+     * @param corrected Output: packedWords(n) words
+     * @param workspace Scratch buffers of the calling thread
+     * @return Bits changed against the hard decisions (-1 if no test
+     *         pattern decodes)
+     */
+    int decodeSoftCodeword(const float* llr, int flips, uint64_t* corrected,
+                           DecodeWorkspace& workspace) const;
+
+    /**
+     * Serialize the encoder descriptor followed by this decoder's method
+     * and syndrome table
+     * @return Descriptor bytes, loadable by both classes
+     */
+    std::vector<uint8_t> exportDescriptor() const;
+
+    /**
+     * Restore the method and syndrome table from a descriptor written by
+     * BCHDecoder::exportDescriptor(); the table is copied, not rebuilt.
+     * The encoder must already be loaded from the same descriptor.
+     * @param data Descriptor bytes
+     * @param size Descriptor length in bytes
+     * @return true if the descriptor is valid for this encoder
+     */
+    bool loadDescriptor(const uint8_t* data, size_t size);
+
    private:
     BCHEncoder& encoder;  // Reference to encoder for parameters
+    BCHDecodeMethod method;
+    DecodeWorkspace workspace;  // Used by the overloads without a workspace
+
+    // Single-word decoding (n <= 64) for all methods
+    uint64_t decodeWord(uint64_t received, int& errorCount,
+                        DecodeWorkspace& workspace) const;
+
+    // Error trapping (cyclic shifts), any n
+    int decodeErrorTrapping(const uint64_t* received, uint64_t* corrected,
+                            DecodeWorkspace& workspace) const;
+
+    // Berlekamp-Massey + Chien search, any n
+    int decodeAlgebraic(const uint64_t* received, uint64_t* corrected,
+                        DecodeWorkspace& workspace) const;
+    // correct*: the same decoders, starting from the syndrome of received
+    int correctAlgebraic(const uint64_t* received, const uint64_t* remainder,
+                         uint64_t* corrected,
+                         DecodeWorkspace& workspace) const;
+
+    // Error trapping that computes the syndrome once and then multiplies
+    // it by x mod g(x) per cyclic shift, any n
+    int decodeMeggitt(const uint64_t* received, uint64_t* corrected,
+                      DecodeWorkspace& workspace) const;
+    int correctMeggitt(const uint64_t* received, uint64_t* syndrome,
+                       uint64_t* corrected, DecodeWorkspace& workspace) const;
+
+    // Coset leader (lowest weight error pattern) for every syndrome
+    std::vector<int8_t> syndromeWeight;        // -1 = uncorrectable
+    std::vector<uint64_t> syndromePattern;     // n <= 64: error pattern
+    std::vector<uint16_t> syndromePositions;   // n > 64: t positions each
+    bool buildSyndromeTable();
+    int decodeSyndromeTable(const uint64_t* received,
+                            uint64_t* corrected) const;
+    int correctSyndromeTable(const uint64_t* received, uint64_t syndrome,
+                             uint64_t* corrected) const;
 
-    // Calculate syndrome vector (binary)
-    std::vector<uint8_t> calculateSyndrome(
-        const std::vector<uint8_t>& received);
+    // Calculate syndrome s(x) = r(x) mod g(x) of a `length`-bit word,
+    // packedWords(n-k) words
+    void calculateSyndrome(const uint64_t* received, int length,
+                           uint64_t* syndrome) const;
 
-    // Calculate Hamming weight
-    int hammingWeight(const std::vector<uint8_t>& vector);
+    // Calculate Hamming weight (popcount)
+    int hammingWeight(const uint64_t* words, int count) const;
 
-    // Cyclic shift right
-    std::vector<uint8_t> cyclicShiftRight(const std::vector<uint8_t>& vector);
+    // Cyclic shift right by one position (multiply by x mod x^n - 1)
+    void cyclicShiftRight(uint64_t* words) const;
 
-    // Cyclic shift left
-    std::vector<uint8_t> cyclicShiftLeft(const std::vector<uint8_t>& vector);
+    // Cyclic shift left by the given number of positions; rotated is
+    // packedWords(n) words of scratch
+    void cyclicShiftLeft(uint64_t* words, int shifts,
+                         uint64_t* rotated) const;
 };
 
 #endif  // BCH_HPP
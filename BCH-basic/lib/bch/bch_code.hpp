@@ -0,0 +1,303 @@
+#ifndef BCH_CODE_HPP
+#define BCH_CODE_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#if defined(ESP8266)
+#include <pgmspace.h>
+#define BCH_CODE_TABLE PROGMEM
+#else
+#define BCH_CODE_TABLE
+#endif
+
+/**
+ * Compile-time BCH code over GF(2^M) correcting T errors
+ *
+ * Same code as BCHEncoder(M, T) with the default primitive polynomial, but
+ * the field tables, g(x) and the parity rows are computed by the compiler:
+ * no initialize(), no heap, and on the ESP8266 the tables live in flash.
+ * Codewords use the packed layout of BCHEncoder::encodePacked (parity in
+ * bits 0..n-k-1, message above), so n must fit one machine word.
+ * Use BCHEncoder when m and t are only known at run time.
+ */
+template <int M, int T>
+class BCHCode {
+    static_assert(M >= 2 && M <= 6, "BCHCode needs 2 <= M <= 6 (n <= 63)");
+    static_assert(T >= 1, "BCHCode needs T >= 1");
+
+   public:
+    static constexpr int m = M;
+    static constexpr int t = T;
+    static constexpr int n = (1 << M) - 1;
+
+    // Packed codeword type: 32 bits when they are enough
+    using Word = typename std::conditional<n <= 32, uint32_t, uint64_t>::type;
+
+   private:
+    static constexpr uint32_t primitivePoly() {
+        // Same defaults as GF2m::defaultPolynomial
+        return M == 2 ? 0b111
+             : M == 3 ? 0b1011
+             : M == 4 ? 0b10011
+             : M == 5 ? 0b100101
+                      : 0b1000011;
+    }
+
+    struct Field {
+        uint16_t alphaToInt[2 * n];  // α^i for i in [0, 2n), doubled
+        int16_t intToAlpha[n + 1];   // Integer to α^i (log table)
+    };
+
+    static constexpr Field buildField() {
+        Field field{};
+        uint32_t value = 1;
+        field.intToAlpha[0] = -1;
+        for (int i = 0; i < n; i++) {
+            field.alphaToInt[i] = field.alphaToInt[i + n] = value;
+            field.intToAlpha[value] = i;
+
+            value <<= 1;
+            if (value & (1u << M)) value ^= primitivePoly();
+        }
+        return field;
+    }
+
+    static constexpr Field field = buildField();
+
+    static constexpr uint16_t fieldMultiply(uint16_t a, uint16_t b) {
+        if (a == 0 || b == 0) return 0;
+        return field.alphaToInt[field.intToAlpha[a] + field.intToAlpha[b]];
+    }
+
+    // g(x) = product of the minimal polynomials of the cyclotomic cosets of
+    // α^1..α^2T (distinct cosets give coprime factors, so this is the LCM)
+    static constexpr uint64_t buildGenerator() {
+        uint16_t poly[n + 1] = {1};
+        int degree = 0;
+        bool used[n] = {};
+
+        for (int i = 1; i <= 2 * T; i++) {
+            if (used[i % n]) continue;  // Already in a coset
+            int element = i % n;
+            do {
+                // poly(x) *= (x + α^element)
+                used[element] = true;
+                uint16_t root = field.alphaToInt[element];
+                degree++;
+                for (int j = degree; j > 0; j--) {
+                    poly[j] = poly[j - 1] ^ fieldMultiply(poly[j], root);
+                }
+                poly[0] = fieldMultiply(poly[0], root);
+                element = (element * 2) % n;
+            } while (!used[element]);
+        }
+
+        uint64_t generator = 0;  // Coefficients are 0 or 1
+        for (int j = 0; j <= degree; j++) {
+            if (poly[j] != 0) generator |= 1ULL << j;
+        }
+        return generator;
+    }
+
+    static constexpr int degreeOf(uint64_t poly) {
+        int degree = -1;
+        for (int j = 0; j < 64; j++) {
+            if ((poly >> j) & 1) degree = j;
+        }
+        return degree;
+    }
+
+   public:
+    static constexpr uint64_t generator = buildGenerator();  // Bit i = g_i
+    static constexpr int k = n - degreeOf(generator);
+    static_assert(k > 0, "T too large for this M");
+
+   private:
+    static constexpr int parityBits = n - k;
+    static constexpr Word parityMask = (Word)((1ULL << parityBits) - 1);
+
+    struct Rows {
+        Word row[k];  // x^(n-k+i) mod g(x) for message bit i
+    };
+
+    static constexpr Rows buildRows() {
+        Rows rows{};
+        uint64_t reg = generator & parityMask;  // x^(n-k) mod g(x)
+        for (int i = 0; i < k; i++) {
+            rows.row[i] = (Word)reg;
+            bool carry = (reg >> (parityBits - 1)) & 1;
+            reg = (reg << 1) & parityMask;
+            if (carry) reg ^= generator & parityMask;
+        }
+        return rows;
+    }
+
+    // Run-time copies of the tables (flash on the ESP8266)
+    alignas(4) static constexpr Field fieldTable BCH_CODE_TABLE = field;
+    alignas(4) static constexpr Rows rowTable BCH_CODE_TABLE = buildRows();
+
+    static uint16_t alphaToInt(int i) {
+#if defined(ESP8266)
+        return pgm_read_word(&fieldTable.alphaToInt[i]);
+#else
+        return fieldTable.alphaToInt[i];
+#endif
+    }
+
+    static int intToAlpha(uint16_t value) {
+#if defined(ESP8266)
+        return (int16_t)pgm_read_word(&fieldTable.intToAlpha[value]);
+#else
+        return fieldTable.intToAlpha[value];
+#endif
+    }
+
+    static Word parityRow(int i) {
+#if defined(ESP8266)
+        const uint32_t* words = (const uint32_t*)&rowTable.row[i];
+        Word row = pgm_read_dword(&words[0]);
+        if (sizeof(Word) > 4) row |= (Word)pgm_read_dword(&words[1]) << 32;
+        return row;
+#else
+        return rowTable.row[i];
+#endif
+    }
+
+    static uint16_t multiply(uint16_t a, uint16_t b) {
+        if (a == 0 || b == 0) return 0;
+        return alphaToInt(intToAlpha(a) + intToAlpha(b));
+    }
+
+    // x^(n-k) * message(x) mod g(x); the loop has a constant trip count k
+    static Word remainder(Word message) {
+        Word parity = 0;
+        for (int i = 0; i < k; i++) {
+            parity ^= parityRow(i) & (Word)(0 - ((message >> i) & 1));
+        }
+        return parity;
+    }
+
+   public:
+    /**
+     * Encode a message systematically
+     * @param message Message bits (k bits, bit i = message[i])
+     * @return Packed codeword (n bits)
+     */
+    static Word encode(Word message) {
+        return (message << parityBits) | remainder(message);
+    }
+
+    /**
+     * Correct a codeword with Berlekamp-Massey + Chien search
+     * @param received Received codeword (n bits)
+     * @param errorCount Output: number of errors corrected (-1 if failed)
+     * @return Corrected codeword (received unchanged on failure)
+     */
+    static Word decodeCodeword(Word received, int& errorCount) {
+        // Binary syndrome s(x) = r(x) mod g(x); zero means no errors
+        Word syndrome =
+            (received & parityMask) ^ remainder(received >> parityBits);
+        if (syndrome == 0) {
+            errorCount = 0;
+            return received;
+        }
+
+        // Power-sum syndromes S_j = s(α^j), S_2j = S_j^2
+        uint16_t S[2 * T + 1] = {};
+        for (int i = 0; i < parityBits; i++) {
+            if (((syndrome >> i) & 1) == 0) continue;
+            for (int j = 1; j < 2 * T; j += 2) {
+                S[j] ^= alphaToInt((i * j) % n);
+            }
+        }
+        for (int j = 2; j <= 2 * T; j += 2) {
+            S[j] = multiply(S[j / 2], S[j / 2]);
+        }
+
+        // Berlekamp-Massey - shortest LFSR Lambda(x) generating S
+        uint16_t lambda[2 * T + 2] = {1};
+        uint16_t prev[2 * T + 2] = {1};
+        int L = 0;
+        int gap = 1;
+        uint16_t prevD = 1;
+        for (int r = 0; r < 2 * T; r++) {
+            uint16_t d = S[r + 1];
+            for (int i = 1; i <= L; i++) {
+                d ^= multiply(lambda[i], S[r + 1 - i]);
+            }
+            if (d == 0) {
+                gap++;
+                continue;
+            }
+
+            uint16_t scale =
+                alphaToInt(intToAlpha(d) + n - intToAlpha(prevD));
+            uint16_t temp[2 * T + 2];
+            for (int i = 0; i < 2 * T + 2; i++) temp[i] = lambda[i];
+            for (int i = 0; i + gap < 2 * T + 2; i++) {
+                lambda[i + gap] ^= multiply(scale, prev[i]);
+            }
+
+            if (2 * L <= r) {
+                L = r + 1 - L;
+                for (int i = 0; i < 2 * T + 2; i++) prev[i] = temp[i];
+                prevD = d;
+                gap = 1;
+            } else {
+                gap++;
+            }
+        }
+
+        if (L > T) {
+            errorCount = -1;
+            return received;
+        }
+
+        // Chien search - Lambda(α^-i) = 0 marks an error at position i.
+        // Terms are kept as logarithms: log(Lambda_j α^-ij) drops by j
+        int logTerm[2 * T + 2] = {};
+        for (int j = 1; j <= L; j++) {
+            logTerm[j] = lambda[j] != 0 ? intToAlpha(lambda[j]) : -1;
+        }
+
+        Word errors = 0;
+        int found = 0;
+        for (int i = 0; i < n; i++) {
+            uint16_t sum = 1;
+            for (int j = 1; j <= L; j++) {
+                if (logTerm[j] < 0) continue;
+                sum ^= alphaToInt(logTerm[j]);
+                logTerm[j] -= j;
+                if (logTerm[j] < 0) logTerm[j] += n;
+            }
+            if (sum == 0) {
+                errors |= (Word)1 << i;
+                found++;
+            }
+        }
+
+        if (found != L) {
+            errorCount = -1;  // Roots outside the code: uncorrectable
+            return received;
+        }
+        errorCount = found;
+        return received ^ errors;
+    }
+
+    /**
+     * Decode a codeword and extract the message
+     * @param received Received codeword (n bits)
+     * @param message Output: corrected message (k bits)
+     * @return Number of errors corrected (-1 if uncorrectable)
+     */
+    static int decode(Word received, Word& message) {
+        int errorCount;
+        Word corrected = decodeCodeword(received, errorCount);
+        if (errorCount < 0) return -1;
+        message = corrected >> parityBits;
+        return errorCount;
+    }
+};
+
+#endif  // BCH_CODE_HPP
@@ -0,0 +1,249 @@
+#include "bch_stream.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Interleaving depth limited to the lanes of one bit-sliced batch
+int checkedDepth(int depth) {
+    int maxDepth = BCHEncoder::batchLanes;
+    if (depth < 1 || depth > maxDepth) {
+        std::cerr << "Interleaving depth must be 1.." << maxDepth << ", got "
+                  << depth << std::endl;
+        return std::min(std::max(depth, 1), maxDepth);
+    }
+    return depth;
+}
+
+uint64_t laneMask(int depth) {
+    return depth < 64 ? (1ULL << depth) - 1 : ~0ULL;
+}
+
+}  // namespace
+
+// ============================================================================
+// BCH STREAM ENCODER
+// ============================================================================
+
+BCHStreamEncoder::BCHStreamEncoder(const BCHEncoder& encoder, int depth)
+    : encoder(encoder),
+      depth(checkedDepth(depth)),
+      inputBits(0),
+      flushPending(false),
+      outputPos(0),
+      outputSize(0) {
+    int n = encoder.getN();
+    int k = encoder.getK();
+    blockBits = this->depth * k;
+    blockBytes = ((size_t)this->depth * n + 7) / 8;
+
+    input.assign(BCHEncoder::packedWords(blockBits + 7), 0);
+    messages.assign(BCHEncoder::batchLanes * BCHEncoder::packedWords(k), 0);
+    slices.assign(n, 0);
+    scratch.assign(BCHEncoder::packedWords(n - k), 0);
+    output.assign((blockBytes + 7) / 8, 0);
+}
+
+size_t BCHStreamEncoder::push(const uint8_t* data, size_t size) {
+    size_t accepted = 0;
+    while (accepted < size && !flushPending) {
+        if (inputBits >= blockBits) {
+            encodeBlock();
+            if (inputBits >= blockBits) break;  // Previous block not pulled
+        }
+        BCHEncoder::depositBits(input.data(), inputBits, 8, data[accepted]);
+        inputBits += 8;
+        accepted++;
+    }
+    encodeBlock();
+    return accepted;
+}
+
+size_t BCHStreamEncoder::pull(uint8_t* out, size_t size) {
+    size_t written = 0;
+    while (written < size && outputSize != 0) {
+        size_t count = std::min(size - written, outputSize - outputPos);
+        for (size_t i = 0; i < count; i++) {
+            size_t byte = outputPos + i;
+            out[written + i] = (uint8_t)(output[byte / 8] >> (8 * (byte % 8)));
+        }
+        written += count;
+        outputPos += count;
+
+        if (outputPos == outputSize) {
+            outputPos = outputSize = 0;
+            encodeBlock();  // Next block, if one is waiting
+        }
+    }
+    return written;
+}
+
+void BCHStreamEncoder::flush() {
+    flushPending = true;
+    encodeBlock();
+}
+
+void BCHStreamEncoder::encodeBlock() {
+    if (outputSize != 0) return;  // Previous block not pulled yet
+    if (flushPending) {
+        if (inputBits == 0) {
+            flushPending = false;
+            return;
+        }
+        inputBits = std::max(inputBits, blockBits);  // Bits above are zero
+    }
+    if (inputBits < blockBits) return;
+
+    int n = encoder.getN();
+    int k = encoder.getK();
+    int parityBits = n - k;
+    int messageWords = BCHEncoder::packedWords(k);
+
+    // Message d is payload bits [d * k, (d + 1) * k); lanes >= D stay zero
+    for (int d = 0; d < depth; d++) {
+        for (int i = 0; i < k; i += 64) {
+            messages[d * messageWords + i / 64] =
+                BCHEncoder::extractBits(input.data(), d * k + i,
+                                        std::min(64, k - i));
+        }
+    }
+    BCHEncoder::toBitSlices(messages.data(), k, slices.data() + parityBits);
+    encoder.encodeBatch(slices.data() + parityBits, slices.data(),
+                        scratch.data());
+
+    // Slice j holds bit j of every codeword: its D low bits are exactly the
+    // interleaved bits j * D .. j * D + D - 1
+    std::fill(output.begin(), output.end(), 0);
+    uint64_t lanes = laneMask(depth);
+    for (int j = 0; j < n; j++) {
+        BCHEncoder::depositBits(output.data(), j * depth, depth,
+                                slices[j] & lanes);
+    }
+    outputPos = 0;
+    outputSize = blockBytes;
+
+    // Keep the bits of the byte that straddled the block end
+    int rest = inputBits - blockBits;
+    uint64_t carry =
+        rest > 0 ? BCHEncoder::extractBits(input.data(), blockBits, rest) : 0;
+    std::fill(input.begin(), input.end(), 0);
+    input[0] = carry;
+    inputBits = rest;
+    if (inputBits == 0) flushPending = false;
+}
+
+// ============================================================================
+// BCH STREAM DECODER
+// ============================================================================
+
+BCHStreamDecoder::BCHStreamDecoder(const BCHEncoder& encoder,
+                                   const BCHDecoder& decoder, int depth)
+    : encoder(encoder),
+      decoder(decoder),
+      depth(checkedDepth(depth)),
+      workspace(encoder),
+      inputSize(0),
+      outputPos(0),
+      outputBits(0),
+      correctedBits(0),
+      failedWords(0) {
+    int n = encoder.getN();
+    int k = encoder.getK();
+    blockBits = this->depth * k;
+    blockBytes = ((size_t)this->depth * n + 7) / 8;
+
+    input.assign((blockBytes + 7) / 8, 0);
+    slices.assign(n, 0);
+    codewords.assign(BCHEncoder::batchLanes * BCHEncoder::packedWords(n), 0);
+    messages.assign(BCHEncoder::batchLanes * BCHEncoder::packedWords(k), 0);
+    output.assign(BCHEncoder::packedWords(blockBits + 7), 0);
+}
+
+size_t BCHStreamDecoder::push(const uint8_t* data, size_t size) {
+    size_t accepted = 0;
+    while (accepted < size) {
+        if (inputSize == blockBytes) {
+            decodeBlock();
+            if (inputSize == blockBytes) break;  // Output not pulled yet
+        }
+        input[inputSize / 8] |= (uint64_t)data[accepted]
+                                << (8 * (inputSize % 8));
+        inputSize++;
+        accepted++;
+    }
+    decodeBlock();
+    return accepted;
+}
+
+size_t BCHStreamDecoder::pull(uint8_t* out, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        if (outputBits - outputPos < 8) {
+            decodeBlock();
+            if (outputBits - outputPos < 8) break;
+        }
+        out[written++] =
+            (uint8_t)BCHEncoder::extractBits(output.data(), outputPos, 8);
+        outputPos += 8;
+    }
+    return written;
+}
+
+void BCHStreamDecoder::decodeBlock() {
+    if (inputSize < blockBytes) return;
+    if (outputBits - outputPos >= 8) return;  // Whole bytes still waiting
+
+    // Move the leftover bits (< 8) to the front of the output buffer
+    int rest = outputBits - outputPos;
+    uint64_t carry =
+        rest > 0 ? BCHEncoder::extractBits(output.data(), outputPos, rest)
+                 : 0;
+    std::fill(output.begin(), output.end(), 0);
+    output[0] = carry;
+    outputPos = 0;
+    outputBits = rest;
+
+    int n = encoder.getN();
+    int k = encoder.getK();
+    int parityBits = n - k;
+    int words = BCHEncoder::packedWords(n);
+    int messageWords = BCHEncoder::packedWords(k);
+
+    // Deinterleave straight into bit slices, then check all words at once
+    for (int j = 0; j < n; j++) {
+        slices[j] = BCHEncoder::extractBits(input.data(), j * depth, depth);
+    }
+    uint64_t dirty = decoder.syndromeBatch(slices.data(), workspace);
+
+    BCHEncoder::fromBitSlices(slices.data() + parityBits, k, messages.data());
+    if (dirty != 0) {
+        BCHEncoder::fromBitSlices(slices.data(), n, codewords.data());
+        while (dirty != 0) {
+            int lane = __builtin_ctzll(dirty);
+            dirty &= dirty - 1;
+
+            // On failure the received message bits are kept
+            int errors = decoder.decodePacked(&codewords[lane * words],
+                                              &messages[lane * messageWords],
+                                              workspace);
+            if (errors < 0) {
+                failedWords++;
+            } else {
+                correctedBits += errors;
+            }
+        }
+    }
+
+    for (int d = 0; d < depth; d++) {
+        for (int i = 0; i < k; i += 64) {
+            BCHEncoder::depositBits(output.data(), outputBits + d * k + i,
+                                    std::min(64, k - i),
+                                    messages[d * messageWords + i / 64]);
+        }
+    }
+    outputBits += blockBits;
+
+    std::fill(input.begin(), input.end(), 0);
+    inputSize = 0;
+}
@@ -0,0 +1,147 @@
+#ifndef BCH_STREAM_HPP
+#define BCH_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bch.hpp"
+
+/**
+ * Byte-stream encoder with block interleaving
+ *
+ * The stream is cut into k-bit messages (bit b of byte i is stream bit
+ * 8i + b). D messages form a block: they are encoded together through the
+ * bit-sliced batch encoder and sent bit-interleaved, bit j of codeword d at
+ * block position j * D + d. A burst of up to D * t bits therefore hits each
+ * codeword in at most t bits. A block is ceil(D * n / 8) bytes on the wire.
+ *
+ * Buffering is bounded to one block of input and one block of output:
+ * push() stops accepting bytes until pull() has drained the previous
+ * block.
+ */
+class BCHStreamEncoder {
+   public:
+    /**
+     * Constructor
+     * @param encoder Initialized (and optionally shortened) encoder
+     * @param depth Interleaving depth D, codewords per block (1..64)
+     */
+    BCHStreamEncoder(const BCHEncoder& encoder, int depth);
+
+    /**
+     * Queue stream bytes for encoding
+     * @param data Input bytes
+     * @param size Number of bytes offered
+     * @return Number of bytes accepted (less than size when the buffers are
+     *         full; pull() and push the rest again)
+     */
+    size_t push(const uint8_t* data, size_t size);
+
+    /**
+     * Take encoded bytes
+     * @param out Output buffer
+     * @param size Capacity of out in bytes
+     * @return Number of bytes written
+     */
+    size_t pull(uint8_t* out, size_t size);
+
+    /**
+     * Pad the current partial block with zero bits and queue it for pull().
+     * The decoder delivers the padding as data, so the payload length must
+     * be known to the receiver. Call pull() until it returns 0 to finish.
+     */
+    void flush();
+
+    int getDepth() const { return depth; }
+    size_t getBlockBytes() const { return blockBytes; }  // Encoded block
+    int getBlockBits() const { return blockBits; }       // Payload per block
+
+   private:
+    const BCHEncoder& encoder;
+    int depth;          // Codewords per block (D)
+    int blockBits;      // Payload bits per block (D * k)
+    size_t blockBytes;  // Encoded bytes per block, ceil(D * n / 8)
+
+    std::vector<uint64_t> input;  // Payload bits, up to blockBits + 7
+    int inputBits;
+    bool flushPending;  // Pad and encode the partial block when possible
+
+    std::vector<uint64_t> messages;  // 64 lanes of packedWords(k) words
+    std::vector<uint64_t> slices;    // n codeword slices
+    std::vector<uint64_t> scratch;   // encodeBatch() scratch
+    std::vector<uint64_t> output;    // Interleaved block
+    size_t outputPos;                // Next byte of output to pull
+    size_t outputSize;               // Bytes in output (0 = free)
+
+    // Encode the first blockBits input bits into output if it is free
+    void encodeBlock();
+};
+
+/**
+ * Byte-stream decoder for BCHStreamEncoder
+ *
+ * Collects one interleaved block, deinterleaves it into bit slices, finds
+ * the codewords with a nonzero syndrome in bulk and decodes only those.
+ * Words that cannot be corrected deliver their received message bits.
+ * Incomplete trailing blocks are never delivered.
+ */
+class BCHStreamDecoder {
+   public:
+    /**
+     * Constructor
+     * @param encoder Encoder of the code (same parameters as the sender)
+     * @param decoder Decoder built on encoder
+     * @param depth Interleaving depth D of the sender (1..64)
+     */
+    BCHStreamDecoder(const BCHEncoder& encoder, const BCHDecoder& decoder,
+                     int depth);
+
+    /**
+     * Queue received bytes
+     * @param data Received bytes
+     * @param size Number of bytes offered
+     * @return Number of bytes accepted (less than size when the buffers are
+     *         full; pull() and push the rest again)
+     */
+    size_t push(const uint8_t* data, size_t size);
+
+    /**
+     * Take decoded stream bytes
+     * @param out Output buffer
+     * @param size Capacity of out in bytes
+     * @return Number of bytes written
+     */
+    size_t pull(uint8_t* out, size_t size);
+
+    int getDepth() const { return depth; }
+    size_t getBlockBytes() const { return blockBytes; }
+    uint64_t getCorrectedBits() const { return correctedBits; }
+    uint64_t getFailedWords() const { return failedWords; }
+
+   private:
+    const BCHEncoder& encoder;
+    const BCHDecoder& decoder;
+    int depth;
+    int blockBits;
+    size_t blockBytes;
+    DecodeWorkspace workspace;
+
+    std::vector<uint64_t> input;  // One interleaved block
+    size_t inputSize;             // Bytes in input
+
+    std::vector<uint64_t> slices;     // n received slices
+    std::vector<uint64_t> codewords;  // 64 lanes of packedWords(n) words
+    std::vector<uint64_t> messages;   // 64 lanes of packedWords(k) words
+    std::vector<uint64_t> output;     // Payload bits, up to blockBits + 7
+    int outputPos;                    // Next bit of output to pull
+    int outputBits;                   // Bits in output
+
+    uint64_t correctedBits;  // Bit errors corrected so far
+    uint64_t failedWords;    // Codewords reported uncorrectable
+
+    // Decode a full input block into output if it has room
+    void decodeBlock();
+};
+
+#endif  // BCH_STREAM_HPP
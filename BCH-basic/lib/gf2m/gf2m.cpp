@@ -0,0 +1,435 @@
+#include "gf2m.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define GF2M_CARRYLESS 1
+#endif
+
+namespace {
+
+// Multiply by α = x modulo the field polynomial
+inline uint16_t multiplyByX(uint16_t a, int m, uint32_t polynomial) {
+    uint32_t value = (uint32_t)a << 1;
+    if (value & (1u << m)) value ^= polynomial;
+    return (uint16_t)value;
+}
+
+#ifdef GF2M_CARRYLESS
+
+// Low 64 bits of the carry-less product a * b
+__attribute__((target("pclmul"))) inline uint64_t carrylessLow(uint64_t a,
+                                                                uint64_t b) {
+    __m128i product = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a),
+                                           _mm_cvtsi64_si128((long long)b),
+                                           0x00);
+    return (uint64_t)_mm_cvtsi128_si64(product);
+}
+
+// Barrett reduction of every lane at once, mu = x^(2m) / p(x):
+// q = ((product >> m) * mu) >> m, remainder = product + q * p(x)
+__attribute__((target("pclmul"))) inline uint64_t carrylessReduce(
+    uint64_t product, int m, uint64_t lowMask, uint64_t highMask,
+    uint32_t polynomial, uint32_t barrett) {
+    uint64_t high = (product >> m) & highMask;
+    uint64_t quotient = (carrylessLow(high, barrett) >> m) & highMask;
+    return (product ^ carrylessLow(quotient, polynomial)) & lowMask;
+}
+
+// Several elements share one 64-bit word, 64 / lanes bits apart. A lane
+// product has at most 2m - 1 bits, so four lanes fit for m <= 8 and two
+// for m <= 16; a carry-less multiply never carries between lanes. Four
+// uint16_t elements are one 64-bit (little-endian) load either way: with
+// two lanes the word is spread over two products.
+template <int lanes, bool accumulate>
+__attribute__((target("pclmul"))) void carrylessRegion(
+    uint16_t* dst, const uint16_t* src, uint16_t c, size_t count, int m,
+    uint32_t polynomial, uint32_t barrett) {
+    const int spacing = 64 / lanes;
+    uint64_t lowMask = 0;   // m bits per lane
+    uint64_t highMask = 0;  // m - 1 bits per lane
+    for (int l = 0; l < lanes; l++) {
+        lowMask |= ((1ULL << m) - 1) << (l * spacing);
+        highMask |= ((1ULL << (m - 1)) - 1) << (l * spacing);
+    }
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint64_t word;
+        std::memcpy(&word, src + i, sizeof(word));
+
+        uint64_t result;
+        if (lanes == 4) {
+            result = carrylessReduce(carrylessLow(word, c), m, lowMask,
+                                     highMask, polynomial, barrett);
+        } else {
+            uint64_t first = (word & 0xFFFF) | ((word & 0xFFFF0000) << 16);
+            uint64_t second = ((word >> 32) & 0xFFFF) |
+                              ((word >> 48) << 32);
+            first = carrylessReduce(carrylessLow(first, c), m, lowMask,
+                                    highMask, polynomial, barrett);
+            second = carrylessReduce(carrylessLow(second, c), m, lowMask,
+                                     highMask, polynomial, barrett);
+            result = (first & 0xFFFF) | ((first >> 16) & 0xFFFF0000) |
+                     ((second & 0xFFFF) << 32) | ((second >> 32) << 48);
+        }
+
+        if (accumulate) {
+            uint64_t old;
+            std::memcpy(&old, dst + i, sizeof(old));
+            result ^= old;
+        }
+        std::memcpy(dst + i, &result, sizeof(result));
+    }
+
+    // Up to three trailing elements, one lane each
+    for (; i < count; i++) {
+        uint16_t value = (uint16_t)carrylessReduce(
+            carrylessLow(src[i], c), m, lowMask, highMask, polynomial,
+            barrett);
+        if (accumulate) {
+            dst[i] ^= value;
+        } else {
+            dst[i] = value;
+        }
+    }
+}
+
+#endif  // GF2M_CARRYLESS
+
+}  // namespace
+
+GF2m::GF2m()
+    : m(0), primitivePoly(0), n(0), backend(GF2mBackend::Table), barrett(0) {}
+
+uint32_t GF2m::defaultPolynomial(int m) {
+    // Default primitive polynomials for GF(2^m)
+    // Represented as binary: bit i represents coefficient of x^i
+    static const std::map<int, uint32_t> defaultPolys = {
+        {2, 0b111},         // x^2 + x + 1
+        {3, 0b1011},        // x^3 + x + 1
+        {4, 0b10011},       // x^4 + x + 1
+        {5, 0b100101},      // x^5 + x^2 + 1
+        {6, 0b1000011},     // x^6 + x + 1
+        {7, 0b10000011},    // x^7 + x + 1
+        {8, 0b100011101},   // x^8 + x^4 + x^3 + x^2 + 1
+        {9, 0x211},         // x^9 + x^4 + 1
+        {10, 0x409},        // x^10 + x^3 + 1
+        {11, 0x805},        // x^11 + x^2 + 1
+        {12, 0x1053},       // x^12 + x^6 + x^4 + x + 1
+        {13, 0x201B},       // x^13 + x^4 + x^3 + x + 1
+        {14, 0x4443},       // x^14 + x^10 + x^6 + x + 1
+        {15, 0x8003},       // x^15 + x + 1
+        {16, 0x1100B}       // x^16 + x^12 + x^3 + x + 1
+    };
+
+    auto it = defaultPolys.find(m);
+    if (it != defaultPolys.end()) {
+        return it->second;
+    }
+    return 0;
+}
+
+bool GF2m::initialize(int m, uint32_t primitivePoly) {
+    if (primitivePoly == 0) primitivePoly = defaultPolynomial(m);
+    if (m < 2 || m > 16 || primitivePoly == 0) {
+        std::cerr << "Unsupported field GF(2^" << m << ")" << std::endl;
+        return false;
+    }
+
+    int fieldSize = 1 << m;  // 2^m
+    int order = fieldSize - 1;
+
+    // Exponents are stored twice (powers[i + n] = powers[i]) so a sum of
+    // two logarithms indexes the table without a modulo
+    std::vector<uint16_t> newPowers(2 * order, 0);
+    std::vector<int> newLogs(fieldSize, -1);
+
+    // α^0 = 1
+    newPowers[0] = 1;
+    newLogs[1] = 0;
+
+    // Generate field elements using primitive polynomial
+    uint32_t value = 1;
+    for (int i = 1; i < order; i++) {
+        // Multiply by α (shift left)
+        value <<= 1;
+
+        // If overflow (bit m is set), reduce using primitive polynomial
+        if (value & (1u << m)) {
+            value ^= primitivePoly;
+        }
+
+        // α must visit every nonzero element before returning to 1
+        if (value == 1 || value >= (uint32_t)fieldSize ||
+            newLogs[value] != -1) {
+            std::cerr << "Polynomial 0x" << std::hex << primitivePoly
+                      << std::dec << " is not primitive for m=" << m
+                      << std::endl;
+            return false;
+        }
+
+        newPowers[i] = value;
+        newLogs[value] = i;
+    }
+
+    for (int i = 0; i < order; i++) {
+        newPowers[i + order] = newPowers[i];
+    }
+
+    this->m = m;
+    this->primitivePoly = primitivePoly;
+    n = order;
+    powers.swap(newPowers);
+    logs.swap(newLogs);
+    buildDerivedTables();
+
+    // PCLMULQDQ packs 4 products per word for m <= 8 and beats the byte
+    // tables there; with 2 lanes for larger m the tables are faster
+    bool carryless = m <= 8 && isSupported(GF2mBackend::CarrylessMultiply);
+    backend = carryless ? GF2mBackend::CarrylessMultiply : GF2mBackend::Table;
+    return true;
+}
+
+void GF2m::buildDerivedTables() {
+    // 1 + α^0 = 0 has no logarithm
+    zechLogs.assign(n, -1);
+    for (int i = 1; i < n; i++) {
+        zechLogs[i] = logs[1 ^ powers[i]];
+    }
+
+    // mu = x^(2m) / p(x) by long division
+    uint64_t dividend = 1ULL << (2 * m);
+    barrett = 0;
+    for (int bit = 2 * m; bit >= m; bit--) {
+        if ((dividend >> bit) & 1) {
+            dividend ^= (uint64_t)primitivePoly << (bit - m);
+            barrett |= 1u << (bit - m);
+        }
+    }
+}
+
+bool GF2m::setBackend(GF2mBackend backend) {
+    if (!isSupported(backend)) {
+        std::cerr << "GF(2^m) backend not supported on this CPU" << std::endl;
+        return false;
+    }
+    this->backend = backend;
+    return true;
+}
+
+bool GF2m::isSupported(GF2mBackend backend) {
+    if (backend != GF2mBackend::CarrylessMultiply) return true;
+#ifdef GF2M_CARRYLESS
+    return __builtin_cpu_supports("pclmul");
+#else
+    return false;
+#endif
+}
+
+uint16_t GF2m::power(uint16_t a, int exponent) const {
+    if (a == 0) return exponent == 0 ? 1 : 0;
+    return powers[(int64_t)logs[a] * exponent % n];
+}
+
+void GF2m::multiplyRegion(uint16_t* dst, const uint16_t* src, uint16_t c,
+                          size_t count) const {
+    region<false>(dst, src, c, count);
+}
+
+void GF2m::multiplyAccumulate(uint16_t* dst, const uint16_t* src, uint16_t c,
+                              size_t count) const {
+    region<true>(dst, src, c, count);
+}
+
+template <bool accumulate>
+void GF2m::region(uint16_t* dst, const uint16_t* src, uint16_t c,
+                  size_t count) const {
+    if (c == 0) {
+        if (!accumulate) std::fill(dst, dst + count, 0);
+        return;
+    }
+
+    switch (backend) {
+        case GF2mBackend::Table:
+            regionTable<accumulate>(dst, src, c, count);
+            return;
+        case GF2mBackend::ZechLog:
+            regionLog<accumulate>(dst, src, c, count);
+            return;
+        case GF2mBackend::CarrylessMultiply:
+#ifdef GF2M_CARRYLESS
+            if (m <= 8) {
+                carrylessRegion<4, accumulate>(dst, src, c, count, m,
+                                               primitivePoly, barrett);
+            } else {
+                carrylessRegion<2, accumulate>(dst, src, c, count, m,
+                                               primitivePoly, barrett);
+            }
+#else
+            regionLog<accumulate>(dst, src, c, count);
+#endif
+            return;
+    }
+}
+
+template <bool accumulate>
+void GF2m::regionTable(uint16_t* dst, const uint16_t* src, uint16_t c,
+                       size_t count) const {
+    // c * x is linear in x: c * (low byte) + c * (high byte * x^8). The two
+    // tables cost 2^min(m, 8) + 2^(m - 8) XORs, so short regions use logs
+    int lowBits = std::min(m, 8);
+    int highBits = m - lowBits;
+    size_t entries = ((size_t)1 << lowBits) + ((size_t)1 << highBits);
+    if (2 * count < entries) {
+        regionLog<accumulate>(dst, src, c, count);
+        return;
+    }
+
+    uint16_t low[256];
+    uint16_t high[256];
+    uint16_t term = c;  // c * x^b
+    low[0] = high[0] = 0;
+    for (int b = 0; b < lowBits; b++) {
+        for (int i = 0; i < (1 << b); i++) low[(1 << b) + i] = low[i] ^ term;
+        term = multiplyByX(term, m, primitivePoly);
+    }
+    for (int b = 0; b < highBits; b++) {
+        for (int i = 0; i < (1 << b); i++) high[(1 << b) + i] = high[i] ^ term;
+        term = multiplyByX(term, m, primitivePoly);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint16_t s = src[i];
+        uint16_t value = highBits > 0 ? low[s & 0xFF] ^ high[s >> 8] : low[s];
+        if (accumulate) {
+            dst[i] ^= value;
+        } else {
+            dst[i] = value;
+        }
+    }
+}
+
+template <bool accumulate>
+void GF2m::regionLog(uint16_t* dst, const uint16_t* src, uint16_t c,
+                     size_t count) const {
+    const uint16_t* shifted = powers.data() + logs[c];  // α^(i + log c)
+    for (size_t i = 0; i < count; i++) {
+        uint16_t s = src[i];
+        uint16_t value = s != 0 ? shifted[logs[s]] : 0;
+        if (accumulate) {
+            dst[i] ^= value;
+        } else {
+            dst[i] = value;
+        }
+    }
+}
+
+void GF2m::evaluate(const uint16_t* poly, int degree, const uint16_t* points,
+                    size_t count, uint16_t* values) const {
+    if (degree < 0) {
+        std::fill(values, values + count, 0);
+        return;
+    }
+
+    if (backend != GF2mBackend::ZechLog) {
+        // Horner per point. Lanes do not help here: every product has a
+        // different multiplier, so CarrylessMultiply shares this path
+        for (size_t i = 0; i < count; i++) {
+            uint16_t x = points[i];
+            uint16_t value = poly[degree];
+            if (x == 0) {
+                values[i] = poly[0];
+                continue;
+            }
+            const uint16_t* shifted = powers.data() + logs[x];
+            for (int j = degree - 1; j >= 0; j--) {
+                value = (value != 0 ? shifted[logs[value]] : 0) ^ poly[j];
+            }
+            values[i] = value;
+        }
+        return;
+    }
+
+    // Horner in the log domain, one coefficient for all points at a time:
+    // values hold logs (0xFFFF = zero), the product is an addition and the
+    // sum with the next coefficient one Zech lookup
+    const uint16_t zero = 0xFFFF;
+    std::fill(values, values + count, zero);
+    for (int j = degree; j >= 0; j--) {
+        int coefficient = logs[poly[j]];
+        for (size_t i = 0; i < count; i++) {
+            int value = values[i];
+            if (value != zero) {
+                int x = logs[points[i]];
+                if (x < 0) {
+                    value = zero;  // Point 0: only poly[0] survives
+                } else {
+                    value += x;
+                    if (value >= n) value -= n;
+                }
+            }
+            if (coefficient >= 0) {
+                if (value == zero) {
+                    value = coefficient;
+                } else {
+                    // α^a + α^b = α^(a + zech(b - a))
+                    int gap = coefficient - value;
+                    if (gap < 0) gap += n;
+                    int sum = zechLogs[gap];
+                    if (sum < 0) {
+                        value = zero;
+                    } else {
+                        value += sum;
+                        if (value >= n) value -= n;
+                    }
+                }
+            }
+            values[i] = (uint16_t)value;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        values[i] = values[i] != zero ? powers[values[i]] : 0;
+    }
+}
+
+void GF2m::evaluatePowers(const uint16_t* poly, int degree, int start,
+                          int step, size_t count, uint16_t* values) const {
+    std::fill(values, values + count, 0);
+    start %= n;
+    if (start < 0) start += n;
+    step %= n;
+    if (step < 0) step += n;
+
+    // Term j contributes poly[j] * α^(j * (start + i * step)): its exponent
+    // advances by j * step per point, with no multiplication. Up to 32
+    // terms are stepped side by side, so their updates do not form one
+    // long dependency chain
+    const int group = 32;
+    int exponents[group];
+    int deltas[group];
+    int j = 0;
+    while (j <= degree) {
+        int terms = 0;
+        for (; j <= degree && terms < group; j++) {
+            if (poly[j] == 0) continue;
+            exponents[terms] = (int)((logs[poly[j]] + (int64_t)j * start) % n);
+            deltas[terms] = (int)((int64_t)j * step % n);
+            terms++;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            uint16_t sum = 0;
+            for (int g = 0; g < terms; g++) {
+                sum ^= powers[exponents[g]];
+                exponents[g] += deltas[g];
+                if (exponents[g] >= n) exponents[g] -= n;
+            }
+            values[i] ^= sum;
+        }
+    }
+}
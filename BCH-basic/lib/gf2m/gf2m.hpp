@@ -0,0 +1,142 @@
+#ifndef GF2M_HPP
+#define GF2M_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Implementation used by the GF2m bulk operations
+ */
+enum class GF2mBackend {
+    Table,             // Product tables of the constant (one byte at a time)
+    ZechLog,           // Log/antilog lookups, Zech logarithms for sums
+    CarrylessMultiply  // PCLMULQDQ and Barrett reduction, several lanes
+};
+
+/**
+ * GF(2^m) arithmetic for 2 <= m <= 16
+ *
+ * Elements are m-bit vectors in the polynomial basis (bit i = coefficient
+ * of x^i, α = x). Scalar operations are inline log/antilog lookups for
+ * every backend; only the bulk operations on whole regions dispatch on the
+ * selected backend. An initialized field is read-only and can be shared
+ * between threads.
+ */
+class GF2m {
+   public:
+    GF2m();
+
+    /**
+     * Build the field tables and select the fastest supported backend
+     * (CarrylessMultiply for m <= 8 where the CPU has it, else Table)
+     * @param m Extension degree, 2..16
+     * @param primitivePoly Primitive polynomial (bit i = coefficient of x^i,
+     *                      0 = built-in)
+     * @return false for an unsupported m or a polynomial that is not
+     *         primitive
+     */
+    bool initialize(int m, uint32_t primitivePoly = 0);
+
+    /**
+     * Override the backend chosen by initialize(). It applies to
+     * multiplyRegion(), multiplyAccumulate() and evaluate() only; scalar
+     * multiply() and friends always use the log tables.
+     * @return false (backend unchanged) if this CPU cannot run it
+     */
+    bool setBackend(GF2mBackend backend);
+    GF2mBackend getBackend() const { return backend; }
+
+    // Run-time CPU check; CarrylessMultiply needs an x86-64 with PCLMULQDQ
+    static bool isSupported(GF2mBackend backend);
+
+    // Built-in primitive polynomial for m (0 if there is none)
+    static uint32_t defaultPolynomial(int m);
+
+    int getM() const { return m; }
+    uint32_t getPolynomial() const { return primitivePoly; }
+    int getOrder() const { return n; }  // 2^m - 1, order of α
+
+    // α^i for 0 <= i < 2 * order (the table is stored twice)
+    uint16_t alpha(int i) const { return powers[i]; }
+
+    // Logarithm to base α, -1 for 0
+    int log(uint16_t a) const { return logs[a]; }
+
+    // Zech logarithm: α^zech(i) = 1 + α^i, -1 when the sum is 0 (i = 0)
+    int zech(int i) const { return zechLogs[i]; }
+
+    static uint16_t add(uint16_t a, uint16_t b) { return a ^ b; }
+
+    uint16_t multiply(uint16_t a, uint16_t b) const {
+        if (a == 0 || b == 0) return 0;
+        return powers[logs[a] + logs[b]];  // Sum < 2n: no modulo
+    }
+
+    // a must be nonzero
+    uint16_t inverse(uint16_t a) const { return powers[n - logs[a]]; }
+
+    // b must be nonzero
+    uint16_t divide(uint16_t a, uint16_t b) const {
+        if (a == 0) return 0;
+        return powers[logs[a] - logs[b] + n];
+    }
+
+    // a^exponent for exponent >= 0
+    uint16_t power(uint16_t a, int exponent) const;
+
+    /**
+     * dst[i] = c * src[i] for i < count (dst may equal src)
+     */
+    void multiplyRegion(uint16_t* dst, const uint16_t* src, uint16_t c,
+                        size_t count) const;
+
+    /**
+     * dst[i] ^= c * src[i] for i < count; with polynomials as coefficient
+     * arrays this is dst(x) += c * src(x)
+     */
+    void multiplyAccumulate(uint16_t* dst, const uint16_t* src, uint16_t c,
+                            size_t count) const;
+
+    /**
+     * values[i] = poly(points[i]) for i < count
+     * @param poly Coefficients, poly[j] for x^j
+     * @param degree Highest index of poly (-1 for the zero polynomial)
+     */
+    void evaluate(const uint16_t* poly, int degree, const uint16_t* points,
+                  size_t count, uint16_t* values) const;
+
+    /**
+     * values[i] = poly(α^(start + i * step)) for i < count: Chien search
+     * (step = -1, i.e. order - 1) and syndromes in one call. Runs on the
+     * log tables for every backend: each nonzero term only needs its
+     * exponent advanced by j * step.
+     */
+    void evaluatePowers(const uint16_t* poly, int degree, int start, int step,
+                        size_t count, uint16_t* values) const;
+
+   private:
+    int m;
+    uint32_t primitivePoly;
+    int n;  // 2^m - 1
+    GF2mBackend backend;
+
+    std::vector<uint16_t> powers;  // α^i for i in [0, 2n), doubled
+    std::vector<int> logs;         // Element to log (-1 for 0)
+    std::vector<int> zechLogs;     // i to log(1 + α^i)
+    uint32_t barrett;              // x^(2m) / p(x), for CarrylessMultiply
+
+    void buildDerivedTables();
+
+    template <bool accumulate>
+    void region(uint16_t* dst, const uint16_t* src, uint16_t c,
+                size_t count) const;
+    template <bool accumulate>
+    void regionTable(uint16_t* dst, const uint16_t* src, uint16_t c,
+                     size_t count) const;
+    template <bool accumulate>
+    void regionLog(uint16_t* dst, const uint16_t* src, uint16_t c,
+                   size_t count) const;
+};
+
+#endif  // GF2M_HPP
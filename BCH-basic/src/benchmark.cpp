@@ -0,0 +1,932 @@
+// Host benchmark for the BCH codec (PlatformIO env: native_benchmark)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "bch.hpp"
+#include "bch_code.hpp"
+#include "bch_stream.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BENCHMARK_MMAP 1
+#endif
+
+struct CodeParams {
+    int m;
+    int t;
+};
+
+// Codes measured by every section
+static const CodeParams benchmarkCodes[] = {
+    {4, 2},  // BCH(15, 7)
+    {5, 2},  // BCH(31, 21)
+    {6, 2},  // BCH(63, 51)
+    {8, 4},  // BCH(255, 223)
+};
+
+// Long codes for storage blocks: decoded with Berlekamp-Massey only, since
+// error trapping needs up to n shifts of an n-bit word per decode
+static const CodeParams longCodes[] = {
+    {13, 8},  // BCH(8191, 8087), ~1 KiB block
+    {14, 8},  // BCH(16383, 16271), ~2 KiB block
+    {16, 8},  // BCH(65535, 65407), ~8 KiB block
+};
+
+static const double minSeconds = 0.3;  // Minimum run time per measurement
+static volatile uint64_t benchmarkSink = 0;
+
+// Every heap allocation of the process goes through these operators. They
+// are not inlined: GCC would otherwise warn about free() on memory from new
+static std::atomic<uint64_t> allocationCount(0);
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size != 0 ? size : 1)) return block;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, size_t) noexcept { operator delete(block); }
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+}
+
+// Initialize quietly - initialize() traces every step to std::cout
+bool initializeQuiet(BCHEncoder& encoder) {
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+    bool ok = encoder.initialize();
+    std::cout.rdbuf(saved);
+    return ok;
+}
+
+std::vector<std::vector<uint8_t>> randomMessages(int k, int count,
+                                                 std::mt19937& rng) {
+    std::vector<std::vector<uint8_t>> messages(count,
+                                               std::vector<uint8_t>(k));
+    for (auto& message : messages) {
+        for (auto& bit : message) bit = rng() & 1;
+    }
+    return messages;
+}
+
+const char* methodName(BCHDecodeMethod method) {
+    switch (method) {
+        case BCHDecodeMethod::ErrorTrapping:
+            return "trapping";
+        case BCHDecodeMethod::BerlekampMassey:
+            return "B-M";
+        case BCHDecodeMethod::SyndromeTable:
+            return "table";
+        case BCHDecodeMethod::Meggitt:
+            return "Meggitt";
+    }
+    return "?";
+}
+
+const char* modeName(BCHEncodeMode mode) {
+    switch (mode) {
+        case BCHEncodeMode::BitSerial:
+            return "bit-serial";
+        case BCHEncodeMode::Table8:
+            return "table-8";
+        case BCHEncodeMode::Table16:
+            return "table-16";
+    }
+    return "?";
+}
+
+void benchmarkEncode(const CodeParams& params) {
+    BCHEncoder encoder(params.m, params.t);
+    if (!initializeQuiet(encoder)) {
+        std::cout << "Failed to initialize m=" << params.m << std::endl;
+        return;
+    }
+
+    std::mt19937 rng(1234);
+    auto messages = randomMessages(encoder.getK(), 1024, rng);
+
+    // Reference codewords from the long-division encoder
+    std::vector<std::vector<uint8_t>> reference;
+    for (const auto& message : messages) {
+        reference.push_back(encoder.encode(message));
+    }
+
+    int messageWords = BCHEncoder::packedWords(encoder.getK());
+    std::vector<uint64_t> packedMessages(messages.size() * messageWords);
+    for (size_t i = 0; i < messages.size(); i++) {
+        BCHEncoder::packBits(messages[i], &packedMessages[i * messageWords]);
+    }
+    std::vector<uint64_t> codeword(BCHEncoder::packedWords(encoder.getN()));
+
+    std::cout << "BCH(" << encoder.getN() << ", " << encoder.getK() << ")"
+              << std::endl;
+
+    const BCHEncodeMode modes[] = {BCHEncodeMode::BitSerial,
+                                   BCHEncodeMode::Table8,
+                                   BCHEncodeMode::Table16};
+    for (BCHEncodeMode mode : modes) {
+        encoder.setEncodeMode(mode);
+
+        bool identical = true;
+        for (size_t i = 0; i < messages.size(); i++) {
+            if (encoder.encode(messages[i]) != reference[i]) identical = false;
+        }
+
+        long encoded = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            for (const auto& message : messages) {
+                encoder.encode(message);
+            }
+            encoded += messages.size();
+            elapsed = secondsSince(start);
+        } while (elapsed < minSeconds);
+
+        long encodedPacked = 0;
+        start = std::chrono::steady_clock::now();
+        double packedSeconds = 0;
+        do {
+            for (size_t i = 0; i < messages.size(); i++) {
+                encoder.encodePacked(&packedMessages[i * messageWords],
+                                     codeword.data());
+            }
+            encodedPacked += messages.size();
+            packedSeconds = secondsSince(start);
+        } while (packedSeconds < minSeconds);
+
+        std::cout << "  encode " << std::setw(10) << modeName(mode) << ": "
+                  << std::setw(10) << std::fixed << std::setprecision(0)
+                  << encoded / elapsed << " codewords/s vector, "
+                  << std::setw(10) << encodedPacked / packedSeconds
+                  << " packed" << (identical ? "" : "  MISMATCH")
+                  << std::endl;
+    }
+    encoder.setEncodeMode(BCHEncodeMode::BitSerial);
+}
+
+// Bit-sliced batches of 64 against per-word packed calls
+void benchmarkBatch(const CodeParams& params) {
+    BCHEncoder encoder(params.m, params.t);
+    if (!initializeQuiet(encoder)) return;
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+    BCHDecoder decoder(encoder, BCHDecodeMethod::BerlekampMassey);
+
+    const int lanes = BCHEncoder::batchLanes;
+    const int batches = 16;
+    int words = BCHEncoder::packedWords(encoder.getN());
+    int messageWords = BCHEncoder::packedWords(encoder.getK());
+
+    std::mt19937 rng(42);
+    std::vector<uint64_t> messages(batches * lanes * messageWords);
+    for (auto& word : messages) {
+        word = ((uint64_t)rng() << 32) | rng();
+    }
+    int topBits = encoder.getK() % 64;
+    if (topBits != 0) {
+        for (size_t i = messageWords - 1; i < messages.size();
+             i += messageWords) {
+            messages[i] &= (1ULL << topBits) - 1;
+        }
+    }
+    std::vector<uint64_t> codewords(batches * lanes * words);
+    std::vector<uint64_t> decoded(lanes * messageWords);
+    std::vector<int> errorCounts(lanes);
+    int count = batches * lanes;
+
+    auto rate = [&](auto body) {
+        long done = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            body();
+            done += count;
+            elapsed = secondsSince(start);
+        } while (elapsed < minSeconds);
+        return done / elapsed;
+    };
+
+    double encodeWord = rate([&] {
+        for (int i = 0; i < count; i++) {
+            encoder.encodePacked(&messages[i * messageWords],
+                                 &codewords[i * words]);
+        }
+    });
+    double encodeBatch = rate([&] {
+        for (int b = 0; b < batches; b++) {
+            encoder.encodeBatchPacked(&messages[b * lanes * messageWords],
+                                      &codewords[b * lanes * words]);
+        }
+    });
+
+    // Clean words: the batch syndrome check filters every lane in bulk
+    double checkWord = rate([&] {
+        for (int i = 0; i < count; i++) {
+            decoder.decodePacked(&codewords[i * words], decoded.data());
+        }
+    });
+    double checkBatch = rate([&] {
+        for (int b = 0; b < batches; b++) {
+            decoder.decodeBatchPacked(&codewords[b * lanes * words],
+                                      decoded.data(), errorCounts.data());
+        }
+    });
+
+    std::cout << "BCH(" << encoder.getN() << ", " << encoder.getK()
+              << "): encode " << std::fixed << std::setprecision(0)
+              << std::setw(10) << encodeWord << " -> " << std::setw(10)
+              << encodeBatch << " codewords/s, clean decode "
+              << std::setw(10) << checkWord << " -> " << std::setw(10)
+              << checkBatch << " /s" << std::endl;
+}
+
+// Compile-time BCHCode<M, T> against the run-time classes (packed, B-M)
+template <int M, int T>
+void benchmarkCompileTime() {
+    using Code = BCHCode<M, T>;
+    BCHEncoder encoder(M, T);
+    if (!initializeQuiet(encoder)) return;
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+    BCHDecoder decoder(encoder, BCHDecodeMethod::BerlekampMassey);
+
+    std::mt19937_64 rng(11);
+    const int count = 1024;
+    std::vector<uint64_t> messages(count);
+    std::vector<uint64_t> received(count);
+    for (int i = 0; i < count; i++) {
+        messages[i] = rng() & ((1ULL << Code::k) - 1);
+        received[i] = Code::encode(messages[i]);
+        received[i] ^= 1ULL << (rng() % Code::n);  // One bit error each
+    }
+
+    auto rate = [&](auto body) {
+        long done = 0;
+        uint64_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            for (int i = 0; i < count; i++) sink += body(i);
+            done += count;
+            elapsed = secondsSince(start);
+        } while (elapsed < minSeconds);
+        benchmarkSink = sink;  // Keep the results alive
+        return done / elapsed;
+    };
+
+    double encodeRuntime =
+        rate([&](int i) { return encoder.encodePacked(messages[i]); });
+    double encodeStatic =
+        rate([&](int i) { return (uint64_t)Code::encode(messages[i]); });
+    double decodeRuntime = rate([&](int i) {
+        int errors;
+        return decoder.decodeCodewordPacked(received[i], errors);
+    });
+    double decodeStatic = rate([&](int i) {
+        int errors;
+        return (uint64_t)Code::decodeCodeword(received[i], errors);
+    });
+
+    std::cout << "BCH(" << Code::n << ", " << Code::k << "): encode "
+              << std::fixed << std::setprecision(0) << std::setw(10)
+              << encodeRuntime << " -> " << std::setw(10) << encodeStatic
+              << " /s, decode (1 error) " << std::setw(10) << decodeRuntime
+              << " -> " << std::setw(10) << decodeStatic << " /s"
+              << std::endl;
+}
+
+// Received words with exactly `weight` bit errors
+std::vector<std::vector<uint8_t>> corruptedCodewords(
+    BCHEncoder& encoder, int weight, int count, std::mt19937& rng) {
+    auto messages = randomMessages(encoder.getK(), count, rng);
+    std::vector<std::vector<uint8_t>> received;
+    for (const auto& message : messages) {
+        std::vector<uint8_t> word = encoder.encode(message);
+        std::vector<bool> hit(word.size(), false);
+        int flipped = 0;
+        while (flipped < weight) {
+            int pos = rng() % word.size();
+            if (hit[pos]) continue;  // Each position at most once
+            hit[pos] = true;
+            word[pos] ^= 1;
+            flipped++;
+        }
+        received.push_back(word);
+    }
+    return received;
+}
+
+// Packed decodes per second over a set of received words
+double packedDecodeRate(BCHDecoder& decoder,
+                        const std::vector<uint64_t>& packed, int words,
+                        int count, uint64_t* message) {
+    long decoded = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < count; i++) {
+            decoder.decodePacked(&packed[i * words], message);
+        }
+        decoded += count;
+        elapsed = secondsSince(start);
+    } while (elapsed < minSeconds);
+    return decoded / elapsed;
+}
+
+void benchmarkDecode(const CodeParams& params) {
+    BCHEncoder encoder(params.m, params.t);
+    if (!initializeQuiet(encoder)) return;
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+    BCHDecoder trapping(encoder, BCHDecodeMethod::ErrorTrapping);
+    BCHDecoder algebraic(encoder, BCHDecodeMethod::BerlekampMassey);
+    BCHDecoder meggitt(encoder, BCHDecodeMethod::Meggitt);
+
+    // The coset-leader table only exists for n-k <= 16
+    bool hasTable = encoder.getN() - encoder.getK() <= 16;
+    BCHDecoder table(encoder, hasTable ? BCHDecodeMethod::SyndromeTable
+                                       : BCHDecodeMethod::ErrorTrapping);
+
+    std::cout << "BCH(" << encoder.getN() << ", " << encoder.getK()
+              << ")     vector   trapping    Meggitt        B-M      table"
+              << " (decodes/s)" << std::endl;
+
+    std::mt19937 rng(99);
+    int words = BCHEncoder::packedWords(encoder.getN());
+    std::vector<uint64_t> message(BCHEncoder::packedWords(encoder.getK()));
+
+    for (int weight = 0; weight <= encoder.getT(); weight++) {
+        auto received = corruptedCodewords(encoder, weight, 256, rng);
+        int count = received.size();
+        std::vector<uint64_t> packed(count * words);
+        for (int i = 0; i < count; i++) {
+            BCHEncoder::packBits(received[i], &packed[i * words]);
+        }
+
+        long decodedVector = 0;
+        std::vector<uint8_t> decoded;
+        auto start = std::chrono::steady_clock::now();
+        double vectorSeconds = 0;
+        do {
+            for (const auto& word : received) {
+                trapping.decode(word, decoded);
+            }
+            decodedVector += count;
+            vectorSeconds = secondsSince(start);
+        } while (vectorSeconds < minSeconds);
+
+        double trappingRate =
+            packedDecodeRate(trapping, packed, words, count, message.data());
+        double meggittRate =
+            packedDecodeRate(meggitt, packed, words, count, message.data());
+        double algebraicRate =
+            packedDecodeRate(algebraic, packed, words, count, message.data());
+
+        std::cout << "  " << weight << " error(s): " << std::setw(10)
+                  << std::fixed << std::setprecision(0)
+                  << decodedVector / vectorSeconds << " " << std::setw(10)
+                  << trappingRate << " " << std::setw(10) << meggittRate
+                  << " " << std::setw(10) << algebraicRate << " "
+                  << std::setw(10);
+        if (hasTable) {
+            std::cout << packedDecodeRate(table, packed, words, count,
+                                          message.data());
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << std::endl;
+    }
+}
+
+const char* backendName(GF2mBackend backend) {
+    switch (backend) {
+        case GF2mBackend::Table:
+            return "table";
+        case GF2mBackend::ZechLog:
+            return "Zech-log";
+        case GF2mBackend::CarrylessMultiply:
+            return "PCLMUL";
+    }
+    return "?";
+}
+
+// GF(2^m) bulk operations on 4096 elements per call, in M elements/s:
+// region multiply-accumulate and evaluation of a degree-8 polynomial
+void benchmarkField(int m) {
+    GF2m field;
+    if (!field.initialize(m)) return;
+
+    const size_t count = 4096;
+    std::mt19937 rng(17);
+    std::vector<uint16_t> src(count), dst(count), points(count);
+    std::vector<uint16_t> values(count), poly(9);
+    for (auto& x : src) x = rng() & field.getOrder();
+    for (auto& x : points) x = rng() & field.getOrder();
+    for (auto& x : poly) x = rng() & field.getOrder();
+
+    auto rate = [&](auto body) {
+        long done = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            body();
+            done += count;
+            elapsed = secondsSince(start);
+        } while (elapsed < minSeconds);
+        benchmarkSink = dst[0] ^ values[0];
+        return done / elapsed / 1e6;
+    };
+
+    const GF2mBackend backends[] = {GF2mBackend::Table, GF2mBackend::ZechLog,
+                                    GF2mBackend::CarrylessMultiply};
+    for (GF2mBackend backend : backends) {
+        if (!GF2m::isSupported(backend)) {
+            std::cout << "GF(2^" << m << ") " << std::setw(8)
+                      << backendName(backend) << ": not supported"
+                      << std::endl;
+            continue;
+        }
+        field.setBackend(backend);
+        uint16_t c = 1;
+        double accumulate = rate([&] {
+            c = c % field.getOrder() + 1;
+            field.multiplyAccumulate(dst.data(), src.data(), c, count);
+        });
+        double evaluate = rate([&] {
+            field.evaluate(poly.data(), 8, points.data(), count,
+                           values.data());
+        });
+        double chien = rate([&] {
+            field.evaluatePowers(poly.data(), 8, 0, -1, count,
+                                 values.data());
+        });
+        std::cout << "GF(2^" << m << ") " << std::setw(8)
+                  << backendName(backend) << ": multiply-accumulate "
+                  << std::fixed << std::setprecision(0) << std::setw(5)
+                  << accumulate << ", evaluate " << std::setw(4) << evaluate
+                  << ", at powers of alpha " << std::setw(4) << chien
+                  << " M/s" << std::endl;
+    }
+}
+
+// Decode rate (t errors) of the full code and of the code shortened to
+// k' message bits
+void benchmarkShortened(const CodeParams& params, int messageLength) {
+    BCHEncoder full(params.m, params.t);
+    BCHEncoder shortened(params.m, params.t);
+    if (!initializeQuiet(full) || !initializeQuiet(shortened) ||
+        !shortened.setMessageLength(messageLength)) {
+        return;
+    }
+
+    std::cout << "BCH(" << full.getN() << ", " << full.getK() << ") -> ("
+              << shortened.getN() << ", " << shortened.getK()
+              << "):" << std::flush;
+    const BCHDecodeMethod methods[] = {BCHDecodeMethod::Meggitt,
+                                       BCHDecodeMethod::BerlekampMassey};
+    for (BCHDecodeMethod method : methods) {
+        double rates[2];
+        BCHEncoder* encoders[] = {&full, &shortened};
+        for (int i = 0; i < 2; i++) {
+            BCHEncoder& encoder = *encoders[i];
+            encoder.setEncodeMode(BCHEncodeMode::Table8);
+            BCHDecoder decoder(encoder, method);
+
+            std::mt19937 rng(11);
+            int count = 256;
+            int words = BCHEncoder::packedWords(encoder.getN());
+            auto received = corruptedCodewords(encoder, params.t, count, rng);
+            std::vector<uint64_t> packed(count * words);
+            for (int w = 0; w < count; w++) {
+                BCHEncoder::packBits(received[w], &packed[w * words]);
+            }
+            std::vector<uint64_t> message(
+                BCHEncoder::packedWords(encoder.getK()));
+            rates[i] =
+                packedDecodeRate(decoder, packed, words, count, message.data());
+        }
+        std::cout << " " << methodName(method) << " " << std::fixed
+                  << std::setprecision(0) << std::setw(8) << rates[0]
+                  << " -> " << std::setw(8) << rates[1];
+    }
+    std::cout << " decodes/s" << std::endl;
+}
+
+// Push src through a stream stage in UART-sized chunks, collecting all output
+template <typename Stream>
+std::vector<uint8_t> runStream(Stream& stream, const std::vector<uint8_t>& src,
+                               size_t chunk) {
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> buffer(4096);
+    size_t pos = 0;
+    while (pos < src.size()) {
+        pos += stream.push(&src[pos], std::min(chunk, src.size() - pos));
+        while (size_t got = stream.pull(buffer.data(), buffer.size())) {
+            out.insert(out.end(), buffer.begin(), buffer.begin() + got);
+        }
+    }
+    return out;
+}
+
+// Byte-stream throughput (payload MB/s) at interleaving depth D: encode,
+// decode of a clean stream and of a stream with one D * t bit burst per block
+void benchmarkStream(const CodeParams& params, int depth) {
+    BCHEncoder encoder(params.m, params.t);
+    if (!initializeQuiet(encoder)) return;
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+    BCHDecoder decoder(encoder, BCHDecodeMethod::BerlekampMassey);
+
+    const size_t payloadBytes = 1 << 20;
+    const size_t chunk = 64;  // Typical UART FIFO read
+    std::mt19937 rng(13);
+    std::vector<uint8_t> payload(payloadBytes);
+    for (auto& byte : payload) byte = rng() & 0xFF;
+
+    BCHStreamEncoder sender(encoder, depth);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> wire = runStream(sender, payload, chunk);
+    sender.flush();
+    std::vector<uint8_t> tail(sender.getBlockBytes());
+    while (size_t got = sender.pull(tail.data(), tail.size())) {
+        wire.insert(wire.end(), tail.begin(), tail.begin() + got);
+    }
+    double encodeSeconds = secondsSince(start);
+
+    BCHStreamDecoder clean(encoder, decoder, depth);
+    start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> received = runStream(clean, wire, chunk);
+    double cleanSeconds = secondsSince(start);
+    bool ok = received.size() >= payloadBytes &&
+              std::equal(payload.begin(), payload.end(), received.begin());
+
+    // One burst of D * t consecutive flipped bits per block
+    int burst = depth * params.t;
+    size_t blockBytes = sender.getBlockBytes();
+    std::vector<uint8_t> noisy = wire;
+    for (size_t block = 0; block + blockBytes <= noisy.size();
+         block += blockBytes) {
+        size_t first = block * 8 + rng() % (blockBytes * 8 - burst + 1);
+        for (int i = 0; i < burst; i++) {
+            noisy[(first + i) / 8] ^= 1 << ((first + i) % 8);
+        }
+    }
+    BCHStreamDecoder bursty(encoder, decoder, depth);
+    start = std::chrono::steady_clock::now();
+    received = runStream(bursty, noisy, chunk);
+    double burstSeconds = secondsSince(start);
+    ok = ok && received.size() >= payloadBytes &&
+         std::equal(payload.begin(), payload.end(), received.begin()) &&
+         bursty.getFailedWords() == 0;
+
+    double megabytes = payloadBytes / 1e6;
+    std::cout << "BCH(" << encoder.getN() << ", " << encoder.getK()
+              << ") D = " << std::setw(2) << depth << ": encode " << std::fixed
+              << std::setprecision(1) << std::setw(6)
+              << megabytes / encodeSeconds << ", decode clean " << std::setw(6)
+              << megabytes / cleanSeconds << ", " << std::setw(4) << burst
+              << "-bit bursts " << std::setw(6) << megabytes / burstSeconds
+              << " MB/s" << (ok ? "" : "  MISMATCH") << std::endl;
+}
+
+// Chase-II over BPSK on an AWGN channel at the given Eb/N0: frame error
+// rate and decode rate of hard decisions (p = 0) and 2^p test patterns
+void benchmarkSoft(const CodeParams& params, double ebN0dB) {
+    BCHEncoder encoder(params.m, params.t);
+    if (!initializeQuiet(encoder)) return;
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+    BCHDecoder decoder(encoder, BCHDecodeMethod::BerlekampMassey);
+    DecodeWorkspace workspace(encoder);
+
+    int n = encoder.getN();
+    int k = encoder.getK();
+    int words = BCHEncoder::packedWords(n);
+    int frames = 1000;
+    double rate = (double)k / n;
+    double sigma = std::sqrt(1.0 / (2.0 * rate * std::pow(10, ebN0dB / 10)));
+
+    // Received LLRs 2y / sigma^2 of random codewords (bit 1 sent as -1)
+    std::mt19937 rng(17);
+    std::normal_distribution<double> noise(0.0, sigma);
+    auto messages = randomMessages(k, frames, rng);
+    std::vector<uint64_t> sent(frames * words);
+    std::vector<float> llr((size_t)frames * n);
+    for (int f = 0; f < frames; f++) {
+        std::vector<uint8_t> codeword = encoder.encode(messages[f]);
+        BCHEncoder::packBits(codeword, &sent[f * words]);
+        for (int i = 0; i < n; i++) {
+            double y = (codeword[i] ? -1.0 : 1.0) + noise(rng);
+            llr[(size_t)f * n + i] = (float)(2 * y / (sigma * sigma));
+        }
+    }
+
+    std::cout << "BCH(" << n << ", " << k << ") " << std::fixed
+              << std::setprecision(1) << ebN0dB << " dB:" << std::flush;
+    std::vector<uint64_t> corrected(words);
+    const int flipCounts[] = {0, 2, 4, 6};
+    for (int flips : flipCounts) {
+        int errors = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            int changed = decoder.decodeSoftCodeword(
+                &llr[(size_t)f * n], flips, corrected.data(), workspace);
+            if (changed < 0 || !std::equal(corrected.begin(), corrected.end(),
+                                           &sent[f * words])) {
+                errors++;
+            }
+        }
+        double seconds = secondsSince(start);
+        std::cout << "  p=" << flips << " FER " << std::setprecision(3)
+                  << (double)errors / frames << " " << std::setprecision(0)
+                  << std::setw(7) << frames / seconds << "/s";
+    }
+    std::cout << std::endl;
+}
+
+// Heap allocations of a stream stage fed src in 64-byte chunks, its output
+// pulled into a fixed buffer
+template <typename Stream>
+uint64_t streamAllocations(Stream& stream, const std::vector<uint8_t>& src) {
+    std::vector<uint8_t> buffer(4096);
+    uint64_t before = allocationCount.load();
+    size_t pos = 0;
+    while (pos < src.size()) {
+        pos += stream.push(&src[pos], std::min<size_t>(64, src.size() - pos));
+        while (stream.pull(buffer.data(), buffer.size()) != 0) {
+        }
+    }
+    return allocationCount.load() - before;
+}
+
+// Heap allocations per decode: vector API, packed API (decoder's own
+// workspace) and packed API with a caller workspace; then per block of the
+// stream encoder and decoder at depth 64
+void benchmarkAllocations(const CodeParams& params) {
+    BCHEncoder encoder(params.m, params.t);
+    if (!initializeQuiet(encoder)) return;
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+
+    std::mt19937 rng(5);
+    int count = 64;
+    int words = BCHEncoder::packedWords(encoder.getN());
+    auto received = corruptedCodewords(encoder, params.t, count, rng);
+    std::vector<uint64_t> packed(count * words);
+    for (int i = 0; i < count; i++) {
+        BCHEncoder::packBits(received[i], &packed[i * words]);
+    }
+    std::vector<uint64_t> message(BCHEncoder::packedWords(encoder.getK()));
+    std::vector<uint8_t> decoded;
+
+    std::cout << "BCH(" << encoder.getN() << ", " << encoder.getK() << ")"
+              << std::endl;
+    const BCHDecodeMethod methods[] = {
+        BCHDecodeMethod::ErrorTrapping, BCHDecodeMethod::Meggitt,
+        BCHDecodeMethod::BerlekampMassey, BCHDecodeMethod::SyndromeTable};
+    bool hasTable = encoder.getN() - encoder.getK() <= 16;
+    for (BCHDecodeMethod method : methods) {
+        if (method == BCHDecodeMethod::SyndromeTable && !hasTable) continue;
+        BCHDecoder decoder(encoder, method);
+        DecodeWorkspace workspace(encoder);
+        decoder.decode(received[0], decoded);  // Grows the decoder's buffers
+
+        uint64_t before = allocationCount.load();
+        for (const auto& word : received) {
+            decoder.decode(word, decoded);
+        }
+        uint64_t vectorAllocs = allocationCount.load() - before;
+
+        before = allocationCount.load();
+        for (int i = 0; i < count; i++) {
+            decoder.decodePacked(&packed[i * words], message.data());
+        }
+        uint64_t packedAllocs = allocationCount.load() - before;
+
+        before = allocationCount.load();
+        for (int i = 0; i < count; i++) {
+            decoder.decodePacked(&packed[i * words], message.data(),
+                                 workspace);
+        }
+        uint64_t workspaceAllocs = allocationCount.load() - before;
+
+        std::cout << "  " << std::setw(8) << methodName(method)
+                  << ": vector " << std::setw(5) << std::setprecision(1)
+                  << (double)vectorAllocs / count << ", packed "
+                  << std::setw(5) << (double)packedAllocs / count
+                  << ", workspace " << std::setw(5)
+                  << (double)workspaceAllocs / count << " allocs/decode"
+                  << std::endl;
+    }
+
+    int depth = BCHEncoder::batchLanes;
+    int blocks = 64;
+    BCHStreamEncoder sender(encoder, depth);
+    std::vector<uint8_t> payload((size_t)blocks * sender.getBlockBits() / 8);
+    for (auto& byte : payload) byte = rng() & 0xFF;
+    std::vector<uint8_t> wire = runStream(sender, payload, 64);
+    uint64_t encodeAllocs = streamAllocations(sender, payload);
+
+    BCHDecoder decoder(encoder, BCHDecodeMethod::BerlekampMassey);
+    BCHStreamDecoder receiver(encoder, decoder, depth);
+    uint64_t decodeAllocs = streamAllocations(receiver, wire);
+    std::cout << "  " << std::setw(8) << "stream"
+              << ": encode " << std::setw(5) << (double)encodeAllocs / blocks
+              << ", decode " << std::setw(5) << (double)decodeAllocs / blocks
+              << " allocs/block" << std::endl;
+}
+
+void benchmarkLongCode(const CodeParams& params) {
+    auto start = std::chrono::steady_clock::now();
+    BCHEncoder encoder(params.m, params.t);
+    if (!initializeQuiet(encoder)) return;
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+    double initMs = secondsSince(start) * 1000;
+    BCHDecoder algebraic(encoder, BCHDecodeMethod::BerlekampMassey);
+
+    std::mt19937 rng(7);
+    int count = 32;
+    int words = BCHEncoder::packedWords(encoder.getN());
+    int messageWords = BCHEncoder::packedWords(encoder.getK());
+    auto messages = randomMessages(encoder.getK(), count, rng);
+    std::vector<uint64_t> packedMessages(count * messageWords);
+    for (int i = 0; i < count; i++) {
+        BCHEncoder::packBits(messages[i], &packedMessages[i * messageWords]);
+    }
+    std::vector<uint64_t> codeword(words);
+    std::vector<uint64_t> message(messageWords);
+
+    long encoded = 0;
+    start = std::chrono::steady_clock::now();
+    double encodeSeconds = 0;
+    do {
+        for (int i = 0; i < count; i++) {
+            encoder.encodePacked(&packedMessages[i * messageWords],
+                                 codeword.data());
+        }
+        encoded += count;
+        encodeSeconds = secondsSince(start);
+    } while (encodeSeconds < minSeconds);
+
+    std::cout << "BCH(" << encoder.getN() << ", " << encoder.getK()
+              << "): init " << std::fixed << std::setprecision(2) << initMs
+              << " ms, encode " << std::setprecision(0)
+              << encoded / encodeSeconds << " codewords/s ("
+              << std::setprecision(1)
+              << encoded / encodeSeconds * encoder.getK() / 8 / 1e6
+              << " MB/s)" << std::endl;
+
+    const int weights[] = {0, 1, params.t};
+    for (int weight : weights) {
+        auto received = corruptedCodewords(encoder, weight, count, rng);
+        std::vector<uint64_t> packed(count * words);
+        for (int i = 0; i < count; i++) {
+            BCHEncoder::packBits(received[i], &packed[i * words]);
+        }
+
+        double rate =
+            packedDecodeRate(algebraic, packed, words, count, message.data());
+        std::cout << "  B-M " << std::setw(2) << weight
+                  << " error(s): " << std::setw(10) << std::setprecision(0)
+                  << rate << " decodes/s (" << std::setprecision(1)
+                  << rate * encoder.getK() / 8 / 1e6 << " MB/s)"
+                  << std::endl;
+    }
+}
+
+// Startup: initialize() + decoder tables against loading a descriptor
+void benchmarkStartup(const CodeParams& params, BCHDecodeMethod method) {
+    auto start = std::chrono::steady_clock::now();
+    BCHEncoder encoder(params.m, params.t);
+    if (!initializeQuiet(encoder)) return;
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+    BCHDecoder decoder(encoder, method);
+    double computeMs = secondsSince(start) * 1000;
+
+    std::vector<uint8_t> blob = decoder.exportDescriptor();
+    const uint8_t* data = blob.data();
+    size_t size = blob.size();
+
+#ifdef BENCHMARK_MMAP
+    // Load through an mmap'd file, as a restarting service would
+    char path[] = "/tmp/bch_descriptor_XXXXXX";
+    int fd = mkstemp(path);
+    void* mapped = MAP_FAILED;
+    if (fd >= 0 && write(fd, blob.data(), blob.size()) == (ssize_t)size) {
+        mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    if (mapped != MAP_FAILED) data = static_cast<const uint8_t*>(mapped);
+#endif
+
+    start = std::chrono::steady_clock::now();
+    BCHEncoder loaded(params.m, params.t);
+    bool ok = loaded.loadDescriptor(data, size);
+    BCHDecoder loadedDecoder(loaded);
+    ok = ok && loadedDecoder.loadDescriptor(data, size);
+    double loadMs = secondsSince(start) * 1000;
+
+#ifdef BENCHMARK_MMAP
+    if (mapped != MAP_FAILED) munmap(mapped, size);
+    if (fd >= 0) {
+        close(fd);
+        unlink(path);
+    }
+#endif
+
+    std::cout << "BCH(" << encoder.getN() << ", " << encoder.getK() << ") "
+              << std::setw(10) << methodName(method) << ": compute "
+              << std::fixed << std::setprecision(3) << std::setw(8)
+              << computeMs << " ms, load " << std::setw(7) << loadMs
+              << " ms, descriptor " << size / 1024.0 << " KiB"
+              << (ok ? "" : "  LOAD FAILED") << std::endl;
+}
+
+int main() {
+    std::cout << "=== BCH encoder throughput ===" << std::endl;
+    for (const auto& params : benchmarkCodes) {
+        benchmarkEncode(params);
+    }
+
+    std::cout << "\n=== Bit-sliced batches (per word -> batch of 64) ==="
+              << std::endl;
+    for (const auto& params : benchmarkCodes) {
+        benchmarkBatch(params);
+    }
+
+    std::cout << "\n=== Compile-time BCHCode<M, T> (run-time -> template) ==="
+              << std::endl;
+    benchmarkCompileTime<4, 2>();
+    benchmarkCompileTime<5, 2>();
+    benchmarkCompileTime<6, 2>();
+
+    std::cout << "\n=== GF(2^m) bulk operations (4096 elements per call) ==="
+              << std::endl;
+    benchmarkField(8);
+    benchmarkField(16);
+
+    std::cout << "\n=== BCH decoder throughput ===" << std::endl;
+    for (const auto& params : benchmarkCodes) {
+        benchmarkDecode(params);
+    }
+
+    std::cout << "\n=== Shortened codes (full -> shortened, t errors) ==="
+              << std::endl;
+    benchmarkShortened({6, 2}, 16);
+    benchmarkShortened({8, 4}, 64);
+    benchmarkShortened({8, 4}, 128);
+    benchmarkShortened({13, 8}, 1024);
+
+    std::cout << "\n=== Byte streams (payload MB/s, 64-byte chunks) ==="
+              << std::endl;
+    const int depths[] = {8, 32, 64};
+    for (int depth : depths) {
+        benchmarkStream({6, 2}, depth);
+    }
+    for (int depth : depths) {
+        benchmarkStream({8, 4}, depth);
+    }
+
+    std::cout << "\n=== Chase-II soft decoding (BPSK/AWGN, FER, decodes/s) ==="
+              << std::endl;
+    benchmarkSoft({6, 2}, 5.0);
+    benchmarkSoft({6, 2}, 4.0);
+    benchmarkSoft({8, 4}, 5.0);
+    benchmarkSoft({8, 4}, 4.0);
+
+    std::cout << "\n=== Heap allocations per decode (t errors) ==="
+              << std::endl;
+    for (const auto& params : benchmarkCodes) {
+        benchmarkAllocations(params);
+    }
+    benchmarkAllocations(longCodes[0]);
+
+    std::cout << "\n=== Long codes (m > 8) ===" << std::endl;
+    for (const auto& params : longCodes) {
+        benchmarkLongCode(params);
+    }
+
+    std::cout << "\n=== Startup: compute vs descriptor ===" << std::endl;
+    benchmarkStartup({8, 2}, BCHDecodeMethod::SyndromeTable);
+    for (const auto& params : longCodes) {
+        benchmarkStartup(params, BCHDecodeMethod::BerlekampMassey);
+    }
+    benchmarkStartup({16, 120}, BCHDecodeMethod::BerlekampMassey);
+    return 0;
+}
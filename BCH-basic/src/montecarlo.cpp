@@ -0,0 +1,293 @@
+// Monte Carlo BER/FER simulation over a binary symmetric channel
+// (PlatformIO env: native_montecarlo)
+//
+// Random messages are encoded, sent through a BSC with crossover
+// probability p and decoded. Frames are simulated in fixed blocks; block b
+// of point i always uses the RNG seeded from (seed, i, b), so results do
+// not depend on the thread count or on which thread ran the block.
+//
+// Usage: program [m] [t] [method] [threads] [frames] [p1,p2,...] [seed]
+//                [k']
+//   m, t     Code parameters (default 4 2, BCH(15, 7))
+//   method   trapping | bm | table | meggitt (default bm)
+//   threads  Worker threads (default: all cores)
+//   frames   Frames per crossover probability (default 1000000)
+//   p list   Comma separated crossover probabilities
+//   seed     Base seed (default 1)
+//   k'       Shortened message length (default: full k)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bch.hpp"
+
+static const uint64_t framesPerBlock = 4096;
+
+struct SimulationStats {
+    uint64_t frames = 0;
+    uint64_t frameErrors = 0;  // Decoded message differs from the sent one
+    uint64_t bitErrors = 0;    // Message bits in error after decoding
+    uint64_t decodeFailures = 0;  // Decoder reported an uncorrectable word
+
+    void merge(const SimulationStats& other) {
+        frames += other.frames;
+        frameErrors += other.frameErrors;
+        bitErrors += other.bitErrors;
+        decodeFailures += other.decodeFailures;
+    }
+};
+
+struct Interval {
+    double low;
+    double high;
+};
+
+// Wilson score interval (95%) for `successes` out of `trials`
+Interval wilsonInterval(uint64_t successes, uint64_t trials) {
+    if (trials == 0) return {0.0, 1.0};
+    const double z = 1.959963984540054;
+    double n = (double)trials;
+    double phat = successes / n;
+    double denominator = 1 + z * z / n;
+    double centre = (phat + z * z / (2 * n)) / denominator;
+    double halfWidth =
+        z * std::sqrt(phat * (1 - phat) / n + z * z / (4 * n * n)) /
+        denominator;
+    if (successes == 0) return {0.0, std::min(1.0, centre + halfWidth)};
+    return {std::max(0.0, centre - halfWidth),
+            std::min(1.0, centre + halfWidth)};
+}
+
+uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Binary symmetric channel: flips each bit with probability p. Error
+// positions are drawn as geometric gaps, so the cost follows the number of
+// errors rather than n.
+class BinarySymmetricChannel {
+   public:
+    explicit BinarySymmetricChannel(double p)
+        : p(p), logKeep(p < 1 ? std::log1p(-p) : 0), uniform(0.0, 1.0) {}
+
+    // Flip bits of a packed word of `bits` bits; returns the error count
+    int transmit(uint64_t* word, int bits, std::mt19937_64& rng) {
+        if (p <= 0) return 0;
+        int flipped = 0;
+        int64_t pos = nextGap(rng);
+        while (pos < bits) {
+            word[pos / 64] ^= 1ULL << (pos % 64);
+            flipped++;
+            pos += 1 + nextGap(rng);
+        }
+        return flipped;
+    }
+
+   private:
+    double p;
+    double logKeep;  // log(1 - p)
+    std::uniform_real_distribution<double> uniform;
+
+    // Error-free bits before the next error
+    int64_t nextGap(std::mt19937_64& rng) {
+        if (p >= 1) return 0;
+        double u = 1.0 - uniform(rng);  // (0, 1]
+        double gap = std::floor(std::log(u) / logKeep);
+        return gap > 1e18 ? (int64_t)1e18 : (int64_t)gap;
+    }
+};
+
+struct PointConfig {
+    double p;
+    uint64_t frames;
+    uint64_t seed;  // Already mixed with the point index
+};
+
+void simulateBlock(const BCHEncoder& encoder, BCHDecoder& decoder,
+                   const PointConfig& point, uint64_t block,
+                   SimulationStats& stats) {
+    int n = encoder.getN();
+    int k = encoder.getK();
+    int words = BCHEncoder::packedWords(n);
+    int messageWords = BCHEncoder::packedWords(k);
+    uint64_t topMask = k % 64 != 0 ? (1ULL << (k % 64)) - 1 : ~0ULL;
+
+    std::mt19937_64 rng(splitMix64(point.seed ^ splitMix64(block)));
+    BinarySymmetricChannel channel(point.p);
+
+    std::vector<uint64_t> message(messageWords);
+    std::vector<uint64_t> codeword(words);
+    std::vector<uint64_t> decoded(messageWords);
+
+    uint64_t first = block * framesPerBlock;
+    uint64_t last = std::min(point.frames, first + framesPerBlock);
+    for (uint64_t frame = first; frame < last; frame++) {
+        for (int w = 0; w < messageWords; w++) {
+            message[w] = rng();
+        }
+        message[messageWords - 1] &= topMask;
+
+        encoder.encodePacked(message.data(), codeword.data());
+        channel.transmit(codeword.data(), n, rng);
+
+        if (decoder.decodePacked(codeword.data(), decoded.data()) < 0) {
+            // Uncorrectable: the receiver keeps the systematic message bits
+            stats.decodeFailures++;
+            std::fill(decoded.begin(), decoded.end(), 0);
+            for (int i = 0; i < k; i++) {
+                int pos = n - k + i;
+                decoded[i / 64] |= ((codeword[pos / 64] >> (pos % 64)) & 1)
+                                   << (i % 64);
+            }
+        }
+
+        int wrong = 0;
+        for (int w = 0; w < messageWords; w++) {
+            wrong += __builtin_popcountll(decoded[w] ^ message[w]);
+        }
+        stats.bitErrors += wrong;
+        stats.frameErrors += wrong != 0;
+        stats.frames++;
+    }
+}
+
+void worker(BCHEncoder& encoder, BCHDecodeMethod method,
+            const PointConfig& point, std::atomic<uint64_t>& nextBlock,
+            uint64_t blocks, SimulationStats& stats) {
+    BCHDecoder decoder(encoder, method);  // Decoders are per thread
+    while (true) {
+        uint64_t block = nextBlock.fetch_add(1);
+        if (block >= blocks) return;
+        simulateBlock(encoder, decoder, point, block, stats);
+    }
+}
+
+bool parseMethod(const char* name, BCHDecodeMethod& method) {
+    if (std::strcmp(name, "trapping") == 0) {
+        method = BCHDecodeMethod::ErrorTrapping;
+    } else if (std::strcmp(name, "bm") == 0) {
+        method = BCHDecodeMethod::BerlekampMassey;
+    } else if (std::strcmp(name, "table") == 0) {
+        method = BCHDecodeMethod::SyndromeTable;
+    } else if (std::strcmp(name, "meggitt") == 0) {
+        method = BCHDecodeMethod::Meggitt;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<double> parseProbabilities(const std::string& list) {
+    std::vector<double> values;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) values.push_back(std::atof(item.c_str()));
+    }
+    return values;
+}
+
+int main(int argc, char** argv) {
+    int m = argc > 1 ? std::atoi(argv[1]) : 4;
+    int t = argc > 2 ? std::atoi(argv[2]) : 2;
+    BCHDecodeMethod method = BCHDecodeMethod::BerlekampMassey;
+    if (argc > 3 && !parseMethod(argv[3], method)) {
+        std::cerr << "Unknown method '" << argv[3]
+                  << "' (trapping, bm, table or meggitt)" << std::endl;
+        return 1;
+    }
+    int threads = argc > 4 ? std::atoi(argv[4]) : 0;
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    uint64_t frames =
+        argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 1000000;
+    std::vector<double> probabilities = parseProbabilities(
+        argc > 6 ? argv[6] : "0.2,0.1,0.05,0.02,0.01,0.005,0.002,0.001");
+    uint64_t seed = argc > 7 ? std::strtoull(argv[7], nullptr, 10) : 1;
+    int messageLength = argc > 8 ? std::atoi(argv[8]) : 0;
+
+    BCHEncoder encoder(m, t);
+    std::ostringstream trace;  // initialize() traces every step
+    std::streambuf* saved = std::cout.rdbuf(trace.rdbuf());
+    bool ok = encoder.initialize();
+    std::cout.rdbuf(saved);
+    if (!ok) {
+        std::cerr << "Failed to initialize BCH encoder" << std::endl;
+        return 1;
+    }
+    if (messageLength > 0 && !encoder.setMessageLength(messageLength)) {
+        return 1;
+    }
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+
+    std::printf("BCH(%d, %d), t = %d, %llu frames per point, %d threads, "
+                "seed %llu\n",
+                encoder.getN(), encoder.getK(), t,
+                (unsigned long long)frames, threads,
+                (unsigned long long)seed);
+    std::printf("Intervals are 95%% Wilson score intervals (BER treats "
+                "message bits as independent)\n\n");
+    std::printf("%10s %11s %24s %11s %24s %11s %11s\n", "p", "FER",
+                "FER 95% CI", "BER", "BER 95% CI", "detected", "frames/s");
+
+    uint64_t blocks = (frames + framesPerBlock - 1) / framesPerBlock;
+    for (size_t i = 0; i < probabilities.size(); i++) {
+        PointConfig point{probabilities[i], frames,
+                          splitMix64(seed * 0x100000001B3ULL + i)};
+
+        std::atomic<uint64_t> nextBlock(0);
+        std::vector<SimulationStats> threadStats(threads);
+        std::vector<std::thread> pool;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int id = 0; id < threads; id++) {
+            pool.emplace_back(worker, std::ref(encoder), method,
+                              std::cref(point), std::ref(nextBlock), blocks,
+                              std::ref(threadStats[id]));
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+        SimulationStats stats;
+        for (const auto& partial : threadStats) {
+            stats.merge(partial);
+        }
+
+        uint64_t bits = stats.frames * (uint64_t)encoder.getK();
+        Interval fer = wilsonInterval(stats.frameErrors, stats.frames);
+        Interval ber = wilsonInterval(stats.bitErrors, bits);
+        char ferRange[64];
+        char berRange[64];
+        std::snprintf(ferRange, sizeof(ferRange), "[%.3e, %.3e]", fer.low,
+                      fer.high);
+        std::snprintf(berRange, sizeof(berRange), "[%.3e, %.3e]", ber.low,
+                      ber.high);
+
+        std::printf("%10.3e %11.4e %24s %11.4e %24s %11.4e %11.0f\n",
+                    point.p, (double)stats.frameErrors / stats.frames,
+                    ferRange, (double)stats.bitErrors / bits, berRange,
+                    (double)stats.decodeFailures / stats.frames,
+                    seconds > 0 ? stats.frames / seconds : 0.0);
+    }
+    return 0;
+}
@@ -19,8 +19,8 @@ void setup() {
 
     encoder.printCodeInfo();
 
-    // Create decoder
-    BCHDecoder decoder(encoder);
+    // Create decoder - n-k = 8, so a 256-entry syndrome table fits easily
+    BCHDecoder decoder(encoder, BCHDecodeMethod::SyndromeTable);
 
     // Example: Encode a message
     int k = encoder.getK();
@@ -0,0 +1,337 @@
+// Exhaustive BCH verification on the host (PlatformIO env: native_tester)
+//
+// Runs the sweep of tester.cpp - every message against every error pattern
+// up to a maximum weight - sharded across all cores. Messages are split
+// into blocks; each thread works through its own deque of blocks and steals
+// from the others when it runs dry. Per-thread statistics are merged at
+// the end.
+//
+// Usage: program [m] [t] [maxWeight] [threads] [method] [maxMessages] [k']
+//   m, t        Code parameters (default 4 2, BCH(15, 7))
+//   maxWeight   Largest error weight tested (default t + 1)
+//   threads     Worker threads (default: all cores)
+//   method      trapping | bm | table | meggitt (default trapping)
+//   maxMessages Messages tested when 2^k is larger; they are drawn
+//               deterministically at random (default 2^20)
+//   k'          Shortened message length (default: full k)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bch.hpp"
+
+// Outcome counts for one error weight
+struct WeightStats {
+    uint64_t correctedCorrectly = 0;
+    uint64_t correctedIncorrectly = 0;  // Decoded to a different message
+    uint64_t detectedOnly = 0;          // Decoder reported failure
+    uint64_t undetected = 0;  // Landed on another codeword, 0 errors seen
+    uint64_t totalTests = 0;
+
+    void merge(const WeightStats& other) {
+        correctedCorrectly += other.correctedCorrectly;
+        correctedIncorrectly += other.correctedIncorrectly;
+        detectedOnly += other.detectedOnly;
+        undetected += other.undetected;
+        totalTests += other.totalTests;
+    }
+};
+
+// Statistics structure (byWeight[w] = tests with exactly w bit errors)
+struct TestStats {
+    uint64_t totalMessages = 0;
+    std::vector<WeightStats> byWeight;
+
+    explicit TestStats(int maxWeight = 0) : byWeight(maxWeight + 1) {}
+
+    void merge(const TestStats& other) {
+        totalMessages += other.totalMessages;
+        for (size_t w = 0; w < byWeight.size(); w++) {
+            byWeight[w].merge(other.byWeight[w]);
+        }
+    }
+};
+
+// A block of message indices [begin, end)
+struct Task {
+    uint64_t begin;
+    uint64_t end;
+};
+
+// Per-thread deque: the owner pops from the back, thieves take the front
+class WorkQueue {
+   public:
+    void push(const Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+    }
+
+    bool pop(Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return false;
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
+
+    bool steal(Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return false;
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
+    }
+
+   private:
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+struct SweepConfig {
+    int maxWeight;
+    BCHDecodeMethod method;
+    bool exhaustive;  // Message index is the message itself
+};
+
+uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Message for an index: the index itself, or a pseudo-random draw
+void generateMessage(int k, uint64_t index, bool exhaustive,
+                     uint64_t* message) {
+    int words = BCHEncoder::packedWords(k);
+    for (int w = 0; w < words; w++) {
+        message[w] = exhaustive ? (w == 0 ? index : 0)
+                                : splitMix64(index * words + w);
+    }
+    if (k % 64 != 0) message[words - 1] &= (1ULL << (k % 64)) - 1;
+}
+
+void runTask(const BCHEncoder& encoder, BCHDecoder& decoder,
+             const SweepConfig& config, const Task& task, TestStats& stats) {
+    int n = encoder.getN();
+    int k = encoder.getK();
+    int words = BCHEncoder::packedWords(n);
+    int messageWords = BCHEncoder::packedWords(k);
+
+    std::vector<uint64_t> message(messageWords);
+    std::vector<uint64_t> codeword(words);
+    std::vector<uint64_t> received(words);
+    std::vector<uint64_t> decoded(messageWords);
+    std::vector<int> pos(config.maxWeight);
+
+    for (uint64_t index = task.begin; index < task.end; index++) {
+        generateMessage(k, index, config.exhaustive, message.data());
+        encoder.encodePacked(message.data(), codeword.data());
+        stats.totalMessages++;
+
+        // Every error pattern of each weight, positions in increasing order
+        for (int weight = 1; weight <= config.maxWeight && weight <= n;
+             weight++) {
+            WeightStats& result = stats.byWeight[weight];
+            for (int i = 0; i < weight; i++) {
+                pos[i] = i;
+            }
+
+            while (true) {
+                received = codeword;
+                for (int i = 0; i < weight; i++) {
+                    received[pos[i] / 64] ^= 1ULL << (pos[i] % 64);
+                }
+
+                int errorsFound =
+                    decoder.decodePacked(received.data(), decoded.data());
+                if (errorsFound < 0) {
+                    result.detectedOnly++;
+                } else if (decoded == message) {
+                    result.correctedCorrectly++;
+                } else if (errorsFound == 0) {
+                    result.undetected++;
+                } else {
+                    result.correctedIncorrectly++;
+                }
+                result.totalTests++;
+
+                // Next combination
+                int i = weight - 1;
+                while (i >= 0 && pos[i] == n - weight + i) i--;
+                if (i < 0) break;
+                pos[i]++;
+                for (int j = i + 1; j < weight; j++) {
+                    pos[j] = pos[j - 1] + 1;
+                }
+            }
+        }
+    }
+}
+
+void worker(int id, std::vector<WorkQueue>& queues, BCHEncoder& encoder,
+            const SweepConfig& config, TestStats& stats) {
+    // Each thread decodes with its own decoder (tables are per instance)
+    BCHDecoder decoder(encoder, config.method);
+    int threads = queues.size();
+
+    Task task;
+    while (true) {
+        bool found = queues[id].pop(task);
+        for (int i = 1; !found && i < threads; i++) {
+            found = queues[(id + i) % threads].steal(task);
+        }
+        if (!found) return;  // No task is ever added, so all work is done
+
+        runTask(encoder, decoder, config, task, stats);
+    }
+}
+
+double percent(uint64_t count, uint64_t total) {
+    return total == 0 ? 0.0 : 100.0 * count / total;
+}
+
+void printSummary(const TestStats& stats) {
+    std::printf("\n========================================\n");
+    std::printf("           TEST SUMMARY\n");
+    std::printf("========================================\n");
+    std::printf("Total messages tested: %llu\n\n",
+                (unsigned long long)stats.totalMessages);
+
+    for (size_t w = 1; w < stats.byWeight.size(); w++) {
+        const WeightStats& s = stats.byWeight[w];
+        std::printf("--- %zu-BIT ERRORS ---\n", w);
+        std::printf("Total tests: %llu\n", (unsigned long long)s.totalTests);
+        std::printf("  Corrected correctly:   %llu (%.2f%%)\n",
+                    (unsigned long long)s.correctedCorrectly,
+                    percent(s.correctedCorrectly, s.totalTests));
+        std::printf("  Corrected incorrectly: %llu (%.2f%%)\n",
+                    (unsigned long long)s.correctedIncorrectly,
+                    percent(s.correctedIncorrectly, s.totalTests));
+        std::printf("  Detected only:         %llu (%.2f%%)\n",
+                    (unsigned long long)s.detectedOnly,
+                    percent(s.detectedOnly, s.totalTests));
+        std::printf("  Undetected:            %llu (%.2f%%)\n\n",
+                    (unsigned long long)s.undetected,
+                    percent(s.undetected, s.totalTests));
+    }
+    std::printf("========================================\n");
+}
+
+bool parseMethod(const char* name, BCHDecodeMethod& method) {
+    if (std::strcmp(name, "trapping") == 0) {
+        method = BCHDecodeMethod::ErrorTrapping;
+    } else if (std::strcmp(name, "bm") == 0) {
+        method = BCHDecodeMethod::BerlekampMassey;
+    } else if (std::strcmp(name, "table") == 0) {
+        method = BCHDecodeMethod::SyndromeTable;
+    } else if (std::strcmp(name, "meggitt") == 0) {
+        method = BCHDecodeMethod::Meggitt;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int m = argc > 1 ? std::atoi(argv[1]) : 4;
+    int t = argc > 2 ? std::atoi(argv[2]) : 2;
+    int maxWeight = argc > 3 ? std::atoi(argv[3]) : t + 1;
+    int threads = argc > 4 ? std::atoi(argv[4]) : 0;
+    BCHDecodeMethod method = BCHDecodeMethod::ErrorTrapping;
+    uint64_t maxMessages =
+        argc > 6 ? std::strtoull(argv[6], nullptr, 10) : 1ULL << 20;
+    int messageLength = argc > 7 ? std::atoi(argv[7]) : 0;
+
+    if (argc > 5 && !parseMethod(argv[5], method)) {
+        std::cerr << "Unknown method '" << argv[5]
+                  << "' (trapping, bm, table or meggitt)" << std::endl;
+        return 1;
+    }
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (maxWeight < 1 || maxMessages == 0) {
+        std::cerr << "maxWeight and maxMessages must be positive"
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n=== BCH Exhaustive Error Correction Test ===\n"
+              << std::endl;
+
+    // initialize() traces every step; keep the output to the summary
+    BCHEncoder encoder(m, t);
+    std::ostringstream trace;
+    std::streambuf* saved = std::cout.rdbuf(trace.rdbuf());
+    bool ok = encoder.initialize();
+    std::cout.rdbuf(saved);
+    if (!ok) {
+        std::cerr << "Failed to initialize BCH encoder" << std::endl;
+        return 1;
+    }
+    if (messageLength > 0 && !encoder.setMessageLength(messageLength)) {
+        return 1;
+    }
+    encoder.setEncodeMode(BCHEncodeMode::Table8);
+    encoder.printCodeInfo();
+
+    int k = encoder.getK();
+    bool exhaustive = k < 64 && (1ULL << k) <= maxMessages;
+    uint64_t messages = exhaustive ? 1ULL << k : maxMessages;
+
+    std::cout << (exhaustive ? "Testing all " : "Testing a sample of ")
+              << messages << " " << k << "-bit messages, error weights 1.."
+              << maxWeight << ", " << threads << " threads" << std::endl;
+
+    // Blocks small enough to balance the load, about 64 per thread
+    uint64_t blockSize = std::max<uint64_t>(1, messages / (threads * 64ULL));
+    std::vector<WorkQueue> queues(threads);
+    int next = 0;
+    for (uint64_t begin = 0; begin < messages; begin += blockSize) {
+        queues[next].push({begin, std::min(messages, begin + blockSize)});
+        next = (next + 1) % threads;
+    }
+
+    SweepConfig config{maxWeight, method, exhaustive};
+    std::vector<TestStats> threadStats(threads, TestStats(maxWeight));
+    std::vector<std::thread> pool;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int id = 0; id < threads; id++) {
+        pool.emplace_back(worker, id, std::ref(queues), std::ref(encoder),
+                          std::cref(config), std::ref(threadStats[id]));
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    TestStats stats(maxWeight);
+    uint64_t decodes = 0;
+    for (const auto& partial : threadStats) {
+        stats.merge(partial);
+    }
+    for (const auto& weight : stats.byWeight) {
+        decodes += weight.totalTests;
+    }
+
+    std::printf("\n=== Testing Complete ===\n");
+    std::printf("Total time: %.3f seconds (%.0f decodes/s)\n", seconds,
+                seconds > 0 ? decodes / seconds : 0.0);
+    printSummary(stats);
+    return 0;
+}
@@ -0,0 +1,379 @@
+// Host micro-benchmark of the codec kernels of all subprojects: BCH
+// encode/decode (BCH-basic), real-valued Lagrange interpolation (RS-basic)
+// and the GF(31) interpolation and Reed-Solomon decoder (RS-gf31).
+// Every kernel reports ns/op, ops/s and heap allocations per op.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bch.hpp"
+#include "gf31_math.hpp"
+#include "gf31_poly.hpp"
+#include "gf31_protocol.hpp"
+#include "reed_solomon.hpp"
+#include "rs.hpp"
+
+// GF(31) decoder of RS-gf31/src/gf31_receiver.cpp (no header of its own)
+struct Point {
+    int x;
+    int y;
+};
+void lagrange_interpolate(Point *pts, int n, int coeffs[]);
+int reed_solomon_decode(Point *pts, int n, int coeffs[], int *error_idx);
+bool tryDecodeWithDuplicates(Point *pts, int n, int decoded_coeffs[]);
+
+// Receiver statistics that reed_solomon_decode counts into
+extern int clean_transmissions;
+extern int corrected_transmissions;
+extern int failed_corrections;
+
+static const double minSeconds = 0.2;  // Minimum run time per kernel
+static volatile uint64_t benchmarkSink = 0;
+
+// Every heap allocation of the process goes through these operators. They
+// are not inlined: GCC would otherwise warn about free() on memory from new
+static std::atomic<uint64_t> allocationCount(0);
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size != 0 ? size : 1)) return block;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, size_t) noexcept { operator delete(block); }
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+}
+
+// Run op(i) for i = 0, 1, ... until minSeconds have passed and print one
+// result line. Inputs are cycled by the caller through i.
+template <typename Op>
+void measure(const std::string& name, Op op) {
+    op(0);  // Warm-up: lazily grown buffers, caches
+
+    uint64_t ops = 0;
+    uint64_t allocations = allocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < 256; i++) {
+            op(ops + i);
+        }
+        ops += 256;
+        elapsed = secondsSince(start);
+    } while (elapsed < minSeconds);
+    allocations = allocationCount.load() - allocations;
+
+    std::cout << std::left << std::setw(56) << name << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << elapsed * 1e9 / ops << " ns/op" << std::setprecision(0)
+              << std::setw(12) << ops / elapsed << " ops/s"
+              << std::setprecision(2) << std::setw(8)
+              << (double)allocations / ops << " allocs/op" << std::endl;
+}
+
+// Initialize quietly - initialize() traces every step to std::cout
+bool initializeQuiet(BCHEncoder& encoder) {
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+    bool ok = encoder.initialize();
+    std::cout.rdbuf(saved);
+    return ok;
+}
+
+const char* methodName(BCHDecodeMethod method) {
+    switch (method) {
+        case BCHDecodeMethod::ErrorTrapping:
+            return "trapping";
+        case BCHDecodeMethod::BerlekampMassey:
+            return "B-M";
+        case BCHDecodeMethod::SyndromeTable:
+            return "table";
+        case BCHDecodeMethod::Meggitt:
+            return "Meggitt";
+    }
+    return "?";
+}
+
+// ============================================================================
+// BCH (BCH-basic)
+// ============================================================================
+
+void benchmarkBCH(int m, int t) {
+    BCHEncoder encoder(m, t);
+    if (!initializeQuiet(encoder)) return;
+    int n = encoder.getN();
+    int k = encoder.getK();
+    std::string code =
+        "BCH(" + std::to_string(n) + ", " + std::to_string(k) + ") ";
+
+    const int count = 64;
+    std::mt19937 rng(1);
+    std::vector<std::vector<uint8_t>> messages(count,
+                                               std::vector<uint8_t>(k));
+    for (auto& message : messages) {
+        for (auto& bit : message) bit = rng() & 1;
+    }
+    measure(code + "encode", [&](uint64_t i) {
+        benchmarkSink += encoder.encode(messages[i % count])[0];
+    });
+
+    std::vector<std::vector<uint8_t>> codewords;
+    for (const auto& message : messages) {
+        codewords.push_back(encoder.encode(message));
+    }
+
+    const BCHDecodeMethod methods[] = {BCHDecodeMethod::ErrorTrapping,
+                                       BCHDecodeMethod::BerlekampMassey};
+    for (BCHDecodeMethod method : methods) {
+        BCHDecoder decoder(encoder, method);
+        std::vector<uint8_t> corrected;
+        for (int weight = 0; weight <= t; weight++) {
+            // Exactly `weight` distinct bit errors per word
+            auto received = codewords;
+            for (int w = 0; w < count; w++) {
+                for (int flipped = 0; flipped < weight;) {
+                    int pos = rng() % n;
+                    if (received[w][pos] != codewords[w][pos]) continue;
+                    received[w][pos] ^= 1;
+                    flipped++;
+                }
+            }
+            measure(code + "decode " + methodName(method) + ", " +
+                        std::to_string(weight) + " errors",
+                    [&](uint64_t i) {
+                        benchmarkSink +=
+                            decoder.decode(received[i % count], corrected);
+                    });
+        }
+    }
+}
+
+// ============================================================================
+// LAGRANGE INTERPOLATION OVER THE REALS (RS-basic)
+// ============================================================================
+
+void benchmarkLagrangeReal() {
+    const int count = 64;
+    std::mt19937 rng(2);
+    std::vector<double> ys(count * 4);
+    for (auto& y : ys) y = (double)(rng() % 256);
+
+    double x[4] = {0, 1, 2, 3};
+    double coeffs[4];
+    measure("lagrangeInterpolation, 4 points", [&](uint64_t i) {
+        lagrangeInterpolation(x, &ys[(i % count) * 4], 4, coeffs);
+        benchmarkSink += (uint64_t)coeffs[0];
+    });
+}
+
+// ============================================================================
+// GF(31) REED-SOLOMON (RS-gf31)
+// ============================================================================
+
+void benchmarkGF31() {
+    // Random degree-3 polynomials, sent as their values at x = 0..5
+    const int count = 64;
+    std::mt19937 rng(3);
+    std::vector<Point> sent(count * 6);
+    for (int w = 0; w < count; w++) {
+        int coeffs[MAX_COEFFS];
+        for (int& c : coeffs) c = rng() % MOD;
+        for (int x = 0; x < 6; x++) {
+            int y = 0;
+            for (int j = MAX_COEFFS - 1; j >= 0; j--) {
+                y = gf_add(gf_mul(y, x), coeffs[j]);
+            }
+            sent[w * 6 + x] = {x, y};
+        }
+    }
+
+    // The words as a compact-protocol byte stream
+    std::vector<uint8_t> stream(count * GF31_FRAME_BYTES);
+    for (int w = 0; w < count; w++) {
+        int symbols[GF31_POINTS];
+        for (int x = 0; x < GF31_POINTS; x++) symbols[x] = sent[w * 6 + x].y;
+        gf31_pack(symbols, &stream[w * GF31_FRAME_BYTES]);
+    }
+    GF31FrameParser parser;
+    measure("GF31FrameParser::push, per byte", [&](uint64_t i) {
+        int symbols[GF31_POINTS];
+        if (parser.push(stream[i % stream.size()], symbols)) {
+            benchmarkSink += symbols[0];
+        }
+    });
+
+    int coeffs[MAX_COEFFS];
+    measure("lagrange_interpolate, 4 points", [&](uint64_t i) {
+        lagrange_interpolate(&sent[(i % count) * 6], 4, coeffs);
+        benchmarkSink += coeffs[0];
+    });
+
+    for (int errors = 0; errors <= 2; errors++) {
+        // `errors` y values changed at distinct positions
+        std::vector<Point> received = sent;
+        for (int w = 0; w < count; w++) {
+            int first = rng() % 6;
+            for (int e = 0; e < errors; e++) {
+                Point& point = received[w * 6 + (first + e) % 6];
+                point.y = gf_add(point.y, 1 + rng() % (MOD - 1));
+            }
+        }
+
+        measure("reed_solomon_decode, " + std::to_string(errors) + " errors",
+                [&](uint64_t i) {
+                    int errorIndex = -1;
+                    benchmarkSink += reed_solomon_decode(
+                        &received[(i % count) * 6], 6, coeffs, &errorIndex);
+                });
+    }
+    // Millions of benchmark decodes are not transmissions
+    clean_transmissions = 0;
+    corrected_transmissions = 0;
+    failed_corrections = 0;
+
+    for (int errors = 1; errors <= 2; errors++) {
+        // `errors` x values changed to another x in 0..5 (sender modes 3
+        // and 5)
+        std::vector<Point> received = sent;
+        for (int w = 0; w < count; w++) {
+            int first = rng() % 6;
+            for (int e = 0; e < errors; e++) {
+                Point& point = received[w * 6 + (first + e) % 6];
+                point.x = (point.x + 1 + rng() % 5) % 6;
+            }
+        }
+
+        measure("tryDecodeWithDuplicates, " + std::to_string(errors) +
+                    " x errors",
+                [&](uint64_t i) {
+                    benchmarkSink += tryDecodeWithDuplicates(
+                        &received[(i % count) * 6], 6, coeffs);
+                });
+    }
+}
+
+// gao_decode with n points (k = 4) and (n - 4) / 2 errors, the most it
+// can correct
+void benchmarkGao(int n) {
+    const int k = MAX_COEFFS;
+    const int errors = (n - k) / 2;
+    const int count = 64;
+    std::mt19937 rng(4);
+    std::vector<int> xs(n), ys(count * n);
+    for (int i = 0; i < n; i++) xs[i] = i;
+    for (int w = 0; w < count; w++) {
+        int coeffs[MAX_COEFFS];
+        for (int& c : coeffs) c = rng() % MOD;
+        for (int i = 0; i < n; i++) {
+            ys[w * n + i] = poly_eval(coeffs, k - 1, i);
+        }
+        int first = rng() % n;
+        for (int e = 0; e < errors; e++) {
+            int& y = ys[w * n + (first + e) % n];
+            y = gf_add(y, 1 + rng() % (MOD - 1));
+        }
+    }
+
+    int coeffs[MAX_COEFFS];
+    measure("gao_decode, n = " + std::to_string(n) + ", " +
+                std::to_string(errors) + " errors",
+            [&](uint64_t i) {
+                benchmarkSink += gao_decode(xs.data(), &ys[(i % count) * n],
+                                            n, k, coeffs, nullptr);
+            });
+}
+
+// ReedSolomon<P, N, K> encoders and decoders (coefficient and systematic
+// form), decoding clean words and words with T errors
+template <int P, int N, int K>
+void benchmarkReedSolomon() {
+    typedef ReedSolomon<P, N, K> Code;
+    const std::string name = "ReedSolomon<" + std::to_string(P) + ", " +
+                             std::to_string(N) + ", " + std::to_string(K) +
+                             ">::";
+    const int count = 64;
+    std::mt19937 rng(5);
+    int xs[N];
+    for (int i = 0; i < N; i++) xs[i] = i;
+    std::vector<int> messages(count * K);
+    for (int& m : messages) m = rng() % P;
+
+    // Systematic words, clean and with T errors
+    std::vector<int> clean(count * N);
+    std::vector<int> ys(count * N);
+    for (int w = 0; w < count; w++) {
+        Code::encode_systematic(&messages[w * K], &clean[w * N]);
+        for (int i = 0; i < N; i++) ys[w * N + i] = clean[w * N + i];
+        int first = rng() % N;
+        for (int e = 0; e < Code::t; e++) {
+            int& y = ys[w * N + (first + e) % N];
+            y = Code::Field::add(y, 1 + rng() % (P - 1));
+        }
+    }
+
+    int y[N];
+    measure(name + "encode", [&](uint64_t i) {
+        Code::encode(&messages[(i % count) * K], y);
+        benchmarkSink += y[N - 1];
+    });
+    measure(name + "encode_systematic", [&](uint64_t i) {
+        Code::encode_systematic(&messages[(i % count) * K], y);
+        benchmarkSink += y[N - 1];
+    });
+
+    int coeffs[K];
+    const std::string errors = std::to_string(Code::t) + " errors";
+    measure(name + "decode, 0 errors", [&](uint64_t i) {
+        benchmarkSink +=
+            Code::decode(xs, &clean[(i % count) * N], coeffs, nullptr);
+    });
+    measure(name + "decode_systematic, 0 errors", [&](uint64_t i) {
+        benchmarkSink += Code::decode_systematic(xs, &clean[(i % count) * N],
+                                                 coeffs, nullptr);
+    });
+    measure(name + "decode, " + errors, [&](uint64_t i) {
+        benchmarkSink +=
+            Code::decode(xs, &ys[(i % count) * N], coeffs, nullptr);
+    });
+    measure(name + "decode_systematic, " + errors, [&](uint64_t i) {
+        benchmarkSink += Code::decode_systematic(xs, &ys[(i % count) * N],
+                                                 coeffs, nullptr);
+    });
+}
+
+int main() {
+    std::cout << "=== BCH-basic ===" << std::endl;
+    benchmarkBCH(4, 2);
+    benchmarkBCH(6, 2);
+    benchmarkBCH(8, 4);
+
+    std::cout << "\n=== RS-basic ===" << std::endl;
+    benchmarkLagrangeReal();
+
+    std::cout << "\n=== RS-gf31 ===" << std::endl;
+    benchmarkGF31();
+    benchmarkGao(6);
+    benchmarkGao(12);
+    benchmarkGao(31);
+    benchmarkReedSolomon<31, 6, 4>();
+    benchmarkReedSolomon<31, 12, 4>();
+    benchmarkReedSolomon<257, 32, 16>();
+    return 0;
+}
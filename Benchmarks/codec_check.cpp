@@ -0,0 +1,424 @@
+// Host correctness check of the codecs the benchmark measures: BCH
+// round trips and descriptors (BCH-basic), the ReedSolomon<P, N, K>
+// decoders (RS-gf31/lib/reed_solomon) and the GF(31) receiver and wire
+// format (RS-gf31). Prints every failed check and exits nonzero if there
+// was one; run by ctest.
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bch.hpp"
+#include "gf31_math.hpp"
+#include "gf31_poly.hpp"
+#include "gf31_protocol.hpp"
+#include "reed_solomon.hpp"
+
+// GF(31) decoder of RS-gf31/src/gf31_receiver.cpp (no header of its own)
+struct Point {
+    int x;
+    int y;
+};
+int reed_solomon_decode(Point *pts, int n, int coeffs[], int *error_idx);
+bool tryDecodeWithDuplicates(Point *pts, int n, int decoded_coeffs[]);
+
+static int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        failures++;
+        std::cout << "FAILED: " << what << std::endl;
+    }
+}
+
+// Run op with std::cout and std::cerr muted: initialize() traces every
+// step, and rejected descriptors are reported on std::cerr
+template <typename Op>
+auto quiet(Op op) -> decltype(op()) {
+    std::ostringstream sink;
+    std::streambuf* savedOut = std::cout.rdbuf(sink.rdbuf());
+    std::streambuf* savedErr = std::cerr.rdbuf(sink.rdbuf());
+    auto result = op();
+    std::cout.rdbuf(savedOut);
+    std::cerr.rdbuf(savedErr);
+    return result;
+}
+
+const char* methodName(BCHDecodeMethod method) {
+    switch (method) {
+        case BCHDecodeMethod::ErrorTrapping:
+            return "trapping";
+        case BCHDecodeMethod::BerlekampMassey:
+            return "B-M";
+        case BCHDecodeMethod::SyndromeTable:
+            return "table";
+        case BCHDecodeMethod::Meggitt:
+            return "Meggitt";
+    }
+    return "?";
+}
+
+// ============================================================================
+// BCH (BCH-basic)
+// ============================================================================
+
+// Every decode method recovers the message from 0..t bit errors, through
+// the vector and the packed API. Error trapping (and Meggitt) only
+// corrects errors that fit in n - k cyclically consecutive positions, so
+// their errors are placed in such a window.
+void checkBCH(int m, int t) {
+    BCHEncoder encoder(m, t);
+    if (!quiet([&] { return encoder.initialize(); })) {
+        check(false, "BCH initialize m=" + std::to_string(m));
+        return;
+    }
+    int n = encoder.getN();
+    int k = encoder.getK();
+    std::string code =
+        "BCH(" + std::to_string(n) + ", " + std::to_string(k) + ") ";
+
+    std::vector<BCHDecodeMethod> methods = {
+        BCHDecodeMethod::ErrorTrapping, BCHDecodeMethod::BerlekampMassey,
+        BCHDecodeMethod::Meggitt};
+    if (n - k <= 16) methods.push_back(BCHDecodeMethod::SyndromeTable);
+
+    std::mt19937 rng(m * 100 + t);
+    int words = BCHEncoder::packedWords(n);
+    std::vector<uint64_t> packed(words);
+    std::vector<uint64_t> decodedPacked(BCHEncoder::packedWords(k));
+    for (BCHDecodeMethod method : methods) {
+        BCHDecoder decoder(encoder, method);
+        std::string name = code + methodName(method);
+        bool trapping = method == BCHDecodeMethod::ErrorTrapping ||
+                        method == BCHDecodeMethod::Meggitt;
+        int window = trapping ? n - k : n;
+        for (int weight = 0; weight <= t; weight++) {
+            for (int trial = 0; trial < 20; trial++) {
+                std::vector<uint8_t> message(k);
+                for (auto& bit : message) bit = rng() & 1;
+                std::vector<uint8_t> received = encoder.encode(message);
+                std::vector<uint8_t> codeword = received;
+                int start = rng() % n;
+                for (int flipped = 0; flipped < weight;) {
+                    int pos = (start + rng() % window) % n;
+                    if (received[pos] != codeword[pos]) continue;
+                    received[pos] ^= 1;
+                    flipped++;
+                }
+
+                std::vector<uint8_t> decoded;
+                int errors = decoder.decode(received, decoded);
+                check(errors == weight && decoded == message,
+                      name + ", " + std::to_string(weight) + " errors");
+
+                BCHEncoder::packBits(received, packed.data());
+                errors = decoder.decodePacked(packed.data(),
+                                              decodedPacked.data());
+                check(errors == weight &&
+                          BCHEncoder::unpackBits(decodedPacked.data(), k) ==
+                              message,
+                      name + " packed, " + std::to_string(weight) +
+                          " errors");
+            }
+        }
+    }
+}
+
+// Offset of the syndrome weights in a BCHDecoder descriptor, 0 if there
+// are none: sections of (tag, length, payload padded to 4 bytes) after
+// the 8-byte header, the decoder section (tag 5) starting with the method
+// and the number of entries
+size_t syndromeWeightsOffset(const std::vector<uint8_t>& blob) {
+    size_t pos = 8;
+    while (pos + 8 <= blob.size()) {
+        uint32_t section[2];
+        memcpy(section, &blob[pos], sizeof(section));
+        if (section[0] == 5) return section[1] > 8 ? pos + 16 : 0;
+        pos += 8 + ((section[1] + 3) & ~3u);
+    }
+    return 0;
+}
+
+// Decoders loaded from a descriptor decode like the original; truncated,
+// mismatched or damaged descriptors are rejected
+void checkDescriptor(int m, int t, BCHDecodeMethod method) {
+    BCHEncoder encoder(m, t);
+    quiet([&] { return encoder.initialize(); });
+    BCHDecoder decoder(encoder, method);
+    std::vector<uint8_t> blob = decoder.exportDescriptor();
+    std::string name = "BCH(" + std::to_string(encoder.getN()) + ", " +
+                       std::to_string(encoder.getK()) + ") " +
+                       methodName(method) + " descriptor";
+
+    auto load = [&](const std::vector<uint8_t>& data, int loadM) {
+        return quiet([&] {
+            BCHEncoder loaded(loadM, t);
+            BCHDecoder loadedDecoder(loaded);
+            return loaded.loadDescriptor(data.data(), data.size()) &&
+                   loadedDecoder.loadDescriptor(data.data(), data.size());
+        });
+    };
+
+    BCHEncoder loaded(m, t);
+    BCHDecoder loadedDecoder(loaded);
+    bool ok = quiet([&] {
+        return loaded.loadDescriptor(blob.data(), blob.size()) &&
+               loadedDecoder.loadDescriptor(blob.data(), blob.size());
+    });
+    check(ok && loadedDecoder.getMethod() == method, name + " loads");
+    if (!ok) return;
+
+    std::mt19937 rng(m + t);
+    int n = encoder.getN();
+    int k = encoder.getK();
+    for (int trial = 0; trial < 50; trial++) {
+        std::vector<uint8_t> message(k);
+        for (auto& bit : message) bit = rng() & 1;
+        std::vector<uint8_t> received = loaded.encode(message);
+        check(received == encoder.encode(message), name + " encode");
+        int errors = rng() % (t + 1);
+        for (int e = 0; e < errors; e++) {
+            received[rng() % n] ^= 1;
+        }
+        std::vector<uint8_t> expected, decoded;
+        int corrected = decoder.decode(received, expected);
+        check(loadedDecoder.decode(received, decoded) == corrected &&
+                  (corrected < 0 || decoded == expected),
+              name + " decode");
+    }
+
+    std::vector<uint8_t> truncated(blob.begin(), blob.end() - 4);
+    check(!load(truncated, m), name + " rejects a truncated blob");
+    check(!load(blob, m + 1), name + " rejects another field");
+
+    size_t weights = syndromeWeightsOffset(blob);
+    if (method == BCHDecodeMethod::SyndromeTable && weights > 0) {
+        std::vector<uint8_t> damaged = blob;
+        damaged[weights + 1] = (uint8_t)(t + 1);
+        check(!load(damaged, m), name + " rejects a weight above t");
+        damaged = blob;
+        damaged[weights + 1] = (uint8_t)-2;
+        check(!load(damaged, m), name + " rejects a negative weight");
+
+        // Move the error of a weight-1 entry past the end of the codeword
+        size_t entries = (size_t)1 << (n - k);
+        size_t entry = 0;
+        while (entry < entries && (int8_t)blob[weights + entry] != 1) {
+            entry++;
+        }
+        damaged = blob;
+        if (n <= 64) {
+            uint64_t pattern = 1ULL << n;
+            memcpy(&damaged[weights + entries + entry * 8], &pattern, 8);
+        } else {
+            uint16_t position = n;
+            memcpy(&damaged[weights + entries + entry * t * 2], &position,
+                   2);
+        }
+        check(entry < entries && !load(damaged, m),
+              name + " rejects an error outside the codeword");
+    }
+}
+
+// ============================================================================
+// REED-SOLOMON OVER GF(P) (RS-gf31/lib/reed_solomon)
+// ============================================================================
+
+// decode, decode_erasures and the systematic encoder and decoder within
+// their error budgets
+template <int P, int N, int K>
+void checkReedSolomon() {
+    typedef ReedSolomon<P, N, K> Code;
+    const std::string name = "ReedSolomon<" + std::to_string(P) + ", " +
+                             std::to_string(N) + ", " + std::to_string(K) +
+                             ">::";
+    std::mt19937 rng(P + N + K);
+    int xs[N];
+    for (int i = 0; i < N; i++) xs[i] = i;
+
+    for (int trial = 0; trial < 200; trial++) {
+        int coeffs[K], data[K], y[N], decoded[K];
+        for (int& c : coeffs) c = rng() % P;
+        for (int& d : data) d = rng() % P;
+
+        // Up to t errors at distinct positions
+        Code::encode(coeffs, y);
+        int errors = trial % (Code::t + 1);
+        int first = rng() % N;
+        for (int e = 0; e < errors; e++) {
+            int& value = y[(first + e) % N];
+            value = Code::Field::add(value, 1 + rng() % (P - 1));
+        }
+        bool ok = Code::decode(xs, y, decoded, nullptr) == errors;
+        for (int i = 0; i < K; i++) ok = ok && decoded[i] == coeffs[i];
+        check(ok, name + "decode, " + std::to_string(errors) + " errors");
+
+        // Systematic: the data are the first K symbols
+        Code::encode_systematic(data, y);
+        ok = true;
+        for (int i = 0; i < K; i++) ok = ok && y[i] == data[i];
+        check(ok, name + "encode_systematic keeps the data");
+        for (int e = 0; e < errors; e++) {
+            int& value = y[(first + e) % N];
+            value = Code::Field::add(value, 1 + rng() % (P - 1));
+        }
+        ok = Code::decode_systematic(xs, y, decoded, nullptr) == errors;
+        for (int i = 0; i < K; i++) ok = ok && decoded[i] == data[i];
+        check(ok, name + "decode_systematic, " + std::to_string(errors) +
+                      " errors");
+
+        // s erased positions (x out of range) and e errors, 2e + s <= N - K
+        Code::encode(coeffs, y);
+        int x[N];
+        for (int i = 0; i < N; i++) x[i] = i;
+        int erasures = rng() % (N - K + 1);
+        int wrong = (N - K - erasures) / 2;
+        for (int s = 0; s < erasures; s++) x[(first + s) % N] = -1;
+        for (int e = 0; e < wrong; e++) {
+            int& value = y[(first + erasures + e) % N];
+            value = Code::Field::add(value, 1 + rng() % (P - 1));
+        }
+        ok = Code::decode_erasures(x, y, N, decoded, nullptr) == wrong;
+        for (int i = 0; i < K; i++) ok = ok && decoded[i] == coeffs[i];
+        check(ok, name + "decode_erasures, " + std::to_string(erasures) +
+                      " erasures, " + std::to_string(wrong) + " errors");
+    }
+}
+
+// ============================================================================
+// GF(31) RECEIVER AND WIRE FORMAT (RS-gf31)
+// ============================================================================
+
+void checkGF31Field() {
+    // The wrappers reduce any int; GF31 itself takes 0..30
+    check(gf_add(31, 0) == 0 && gf_add(-1, 0) == 30 && gf_add(-32, 2) == 1,
+          "gf_add reduces its operands");
+    check(gf_mul(31, 5) == 0 && gf_mul(-1, 1) == 30 && gf_mul(33, 33) == 4,
+          "gf_mul reduces its operands");
+    check(gf_inv(32) == 1 && gf_mul(gf_inv(-2), 29) == 1,
+          "gf_inv reduces its operand");
+    bool ok = true;
+    for (int a = 1; a < MOD; a++) ok = ok && gf_mul(a, gf_inv(a)) == 1;
+    check(ok, "gf_inv is the inverse");
+}
+
+void checkGF31Receiver() {
+    std::mt19937 rng(31);
+    for (int trial = 0; trial < 300; trial++) {
+        int coeffs[MAX_COEFFS];
+        for (int& c : coeffs) c = rng() % MOD;
+        Point sent[GF31_POINTS];
+        for (int x = 0; x < GF31_POINTS; x++) {
+            sent[x] = {x, poly_eval(coeffs, MAX_COEFFS - 1, x)};
+        }
+
+        // 0 or 1 y errors
+        Point received[GF31_POINTS];
+        memcpy(received, sent, sizeof(sent));
+        int errors = trial % 2;
+        int position = rng() % GF31_POINTS;
+        if (errors) {
+            received[position].y =
+                gf_add(received[position].y, 1 + rng() % (MOD - 1));
+        }
+        int decoded[MAX_COEFFS];
+        int errorIndex = -1;
+        bool ok = reed_solomon_decode(received, GF31_POINTS, decoded,
+                                      &errorIndex) == errors &&
+                  (!errors || errorIndex == position);
+        for (int i = 0; i < MAX_COEFFS; i++) {
+            ok = ok && decoded[i] == coeffs[i];
+        }
+        check(ok, "reed_solomon_decode, " + std::to_string(errors) +
+                      " errors");
+
+        // One x error: another position (duplicate) or out of range
+        memcpy(received, sent, sizeof(sent));
+        received[position].x = trial % 3 == 0
+                                   ? 7
+                                   : (position + 1 + rng() % 5) % 6;
+        ok = tryDecodeWithDuplicates(received, GF31_POINTS, decoded);
+        for (int i = 0; i < MAX_COEFFS; i++) {
+            ok = ok && decoded[i] == coeffs[i];
+        }
+        check(ok, "tryDecodeWithDuplicates, 1 x error");
+    }
+}
+
+void checkGF31Protocol() {
+    std::mt19937 rng(7);
+    const int frames = 64;
+    std::vector<int> symbols(frames * GF31_POINTS);
+    std::vector<uint8_t> stream(frames * GF31_FRAME_BYTES);
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < GF31_POINTS; i++) {
+            symbols[f * GF31_POINTS + i] = rng() % 32;
+        }
+        gf31_pack(&symbols[f * GF31_POINTS], &stream[f * GF31_FRAME_BYTES]);
+    }
+
+    bool ok = true;
+    for (int f = 0; f < frames; f++) {
+        int unpacked[GF31_POINTS];
+        ok = ok && gf31_unpack(&stream[f * GF31_FRAME_BYTES], unpacked) &&
+             memcmp(unpacked, &symbols[f * GF31_POINTS], sizeof(unpacked)) ==
+                 0;
+    }
+    check(ok, "gf31_pack / gf31_unpack round trip");
+
+    uint8_t frame[GF31_FRAME_BYTES];
+    int unpacked[GF31_POINTS];
+    memcpy(frame, &stream[0], GF31_FRAME_BYTES);
+    frame[0] ^= 1;
+    check(!gf31_unpack(frame, unpacked), "gf31_unpack rejects a bad sync");
+    memcpy(frame, &stream[0], GF31_FRAME_BYTES);
+    frame[GF31_FRAME_BYTES - 1] |= 1;
+    check(!gf31_unpack(frame, unpacked), "gf31_unpack rejects padding");
+
+    // A byte lost in frame 10: the parser loses that frame only
+    const int lost = 10;
+    GF31FrameParser parser;
+    std::vector<int> accepted;
+    for (size_t b = 0; b < stream.size(); b++) {
+        if (b == lost * GF31_FRAME_BYTES + 2) continue;
+        if (parser.push(stream[b], unpacked)) {
+            accepted.insert(accepted.end(), unpacked,
+                            unpacked + GF31_POINTS);
+        }
+    }
+    std::vector<int> expected = symbols;
+    expected.erase(expected.begin() + lost * GF31_POINTS,
+                   expected.begin() + (lost + 1) * GF31_POINTS);
+    check(accepted == expected, "GF31FrameParser resynchronizes");
+}
+
+int main() {
+    checkBCH(4, 2);
+    checkBCH(6, 3);
+    checkBCH(8, 2);
+    checkBCH(8, 4);
+    checkBCH(10, 3);
+    checkDescriptor(6, 2, BCHDecodeMethod::SyndromeTable);
+    checkDescriptor(8, 2, BCHDecodeMethod::SyndromeTable);
+    checkDescriptor(10, 4, BCHDecodeMethod::BerlekampMassey);
+
+    checkReedSolomon<31, 6, 4>();
+    checkReedSolomon<31, 12, 4>();
+    checkReedSolomon<257, 32, 16>();
+    checkReedSolomon<65521, 20, 8>();
+
+    checkGF31Field();
+    checkGF31Receiver();
+    checkGF31Protocol();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
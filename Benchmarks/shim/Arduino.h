@@ -0,0 +1,56 @@
+// Minimal host stand-in for the Arduino core, enough to compile the codec
+// sources of the ESP8266 projects natively. Output goes to stdout; there is
+// no serial input.
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using std::abs;  // Arduino's abs() also takes doubles
+
+inline unsigned long millis() {
+    static const auto start = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<
+               std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                          start)
+        .count();
+}
+
+inline void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+class HardwareSerial {
+   public:
+    void begin(unsigned long) {}
+    int available() { return 0; }
+    int read() { return -1; }
+
+    template <typename T>
+    void print(const T& value) {
+        std::cout << value;
+    }
+    void print(double value, int digits) {
+        std::streamsize saved = std::cout.precision(digits);
+        std::cout << std::fixed << value << std::defaultfloat;
+        std::cout.precision(saved);
+    }
+    void println() { std::cout << '\n'; }
+    template <typename T>
+    void println(const T& value) {
+        print(value);
+        println();
+    }
+    void println(double value, int digits) {
+        print(value, digits);
+        println();
+    }
+
+    explicit operator bool() const { return true; }
+};
+
+inline HardwareSerial Serial;
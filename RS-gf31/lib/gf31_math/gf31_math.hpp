@@ -1,36 +1,39 @@
 #pragma once
 #include <Arduino.h>
 
+#include "reed_solomon.hpp"
+
 #define MOD 31
 #define MAX_COEFFS 4
 
+// GF(31) through PrimeField<31>: multiplication and inverse are lookups
+// in 31x31 and 31-entry tables kept in flash, addition is a compare and
+// subtract. The ESP8266 has no hardware divider, so no % is left on
+// these paths. GF31 operands must be reduced (0..30); the gf_* wrappers
+// below take any int, as received values may be out of range.
+typedef PrimeField<MOD> GF31;
+
+// a mod 31 for any int, Barrett instead of %. For a < 0,
+// a mod 31 = 30 - (-a - 1) mod 31 and -a - 1 = ~a
+inline int gf_reduce(int a) {
+  return a >= 0 ? GF31::reduce((uint32_t)a)
+                : MOD - 1 - GF31::reduce((uint32_t)~a);
+}
+
 // Dodawanie w GF(31)
 inline int gf_add(int a, int b) {
-  int r = (a + b) % MOD;
-  if (r < 0) r += MOD;
-  return r;
+  return GF31::add(gf_reduce(a), gf_reduce(b));
 }
 
 // Mnożenie w GF(31)
 inline int gf_mul(int a, int b) {
-  int r = (a * b) % MOD;
-  if (r < 0) r += MOD;
-  return r;
+  return GF31::mul(gf_reduce(a), gf_reduce(b));
 }
 
 // Szybkie potęgowanie (x^p mod 31)
 inline int gf_pow(int base, int exp) {
-  int res = 1;
-  while (exp > 0) {
-    if (exp & 1) res = gf_mul(res, base);
-    base = gf_mul(base, base);
-    exp >>= 1;
-  }
-  return res;
+  return GF31::pow(gf_reduce(base), exp);
 }
 
 // Odwrotność w GF(31)
-inline int gf_inv(int a) {
-  // ponieważ 31 to liczba pierwsza → a^(p−2) mod p
-  return gf_pow(a, MOD - 2);
-}
\ No newline at end of file
+inline int gf_inv(int a) { return GF31::inv(gf_reduce(a)); }
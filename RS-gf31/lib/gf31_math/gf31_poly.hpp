@@ -0,0 +1,43 @@
+#pragma once
+#include "gf31_math.hpp"
+#include "reed_solomon.hpp"
+
+// Polynomials over GF(31) with run-time sizes: coefficient arrays, lowest
+// power first (p[i] is the coefficient of x^i), degree -1 for p = 0. Thin
+// wrappers around PrimePoly from the reed_solomon library.
+
+// Distinct x values in GF(31): the longest possible codeword
+#define GF_MAX_POINTS MOD
+#define GF_POLY_SIZE (GF_MAX_POINTS + 1)
+
+typedef PrimePoly<MOD, GF_POLY_SIZE> GF31Poly;
+
+// Degree of p (highest nonzero coefficient below size), -1 for p = 0
+inline int poly_degree(const int p[], int size) {
+  return GF31Poly::degree(p, size);
+}
+
+// p(x) by Horner's rule
+inline int poly_eval(const int p[], int deg, int x) {
+  return GF31Poly::eval(p, deg, x);
+}
+
+// a = q * b + r with deg r < deg b (b != 0). q and r are GF_POLY_SIZE
+// arrays; r may be a.
+inline void poly_divmod(const int a[], int deg_a, const int b[], int deg_b,
+                        int q[], int r[]) {
+  GF31Poly::divmod(a, deg_a, b, deg_b, q, r);
+}
+
+// Gao's Reed-Solomon decoder for any n <= 31 points and k <= n message
+// coefficients: corrects up to (n - k) / 2 wrong y values in O(n^2).
+//
+// coeffs:    Output, k coefficients of f
+// error_idx: Optional output (may be nullptr, else room for n entries),
+//            indices i of the corrected points
+// Returns the number of corrected errors, or -1 if the points are not
+// within (n - k) / 2 errors of any codeword (or the input is invalid)
+inline int gao_decode(const int x[], const int y[], int n, int k,
+                      int coeffs[], int error_idx[]) {
+  return GF31Poly::gao(x, y, n, k, coeffs, error_idx);
+}
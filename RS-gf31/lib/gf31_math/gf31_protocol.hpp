@@ -0,0 +1,100 @@
+#pragma once
+#include <stdint.h>
+
+// Wire format of the GF(31) link, shared by sender and receiver.
+//
+// 0 = legacy: 4 raw message bytes (not with GF31_SYSTEMATIC), then one
+//     byte (x << 5 | y) per point
+// 1 = compact: a message is a sync byte followed by the 6 code symbols
+//     (y at x = 0..5, x implied by the position) packed 5 bits each, first
+//     symbol in the high bits, zero padded: 5 bytes instead of 10. There
+//     is no x field, so the x-error test modes are not available.
+#ifndef GF31_COMPACT_PROTOCOL
+#define GF31_COMPACT_PROTOCOL 0
+#endif
+
+// 0 = the data are the coefficients of f, and y = f(x)
+// 1 = systematic encoding: the 4 data symbols are sent as the code
+//     symbols at x = 0..3, followed by 2 parity symbols. The data are
+//     then on the wire already, and the legacy format drops its raw
+//     message bytes: 6 bytes instead of 10.
+#ifndef GF31_SYSTEMATIC
+#define GF31_SYSTEMATIC 0
+#endif
+
+// Whether the message is sent in the clear ahead of the points
+#define GF31_RAW_DATA (!GF31_COMPACT_PROTOCOL && !GF31_SYSTEMATIC)
+
+// Code symbols per message, x = 0..GF31_POINTS-1
+#define GF31_POINTS 6
+
+#define GF31_SYNC_BYTE 0x7E
+#define GF31_SYMBOL_BITS 5
+#define GF31_FRAME_BYTES (1 + (GF31_POINTS * GF31_SYMBOL_BITS + 7) / 8)
+
+// The sender's test message. With GF31_RAW_DATA the receiver checks its
+// decoded data against the raw message bytes; otherwise only the code
+// symbols are sent, and it compares against this copy.
+#define GF31_TEST_MESSAGE {5, 7, 3, 2}
+
+// frame = sync byte and the packed symbols (each 0..31)
+inline void gf31_pack(const int symbols[GF31_POINTS],
+                      uint8_t frame[GF31_FRAME_BYTES]) {
+  frame[0] = GF31_SYNC_BYTE;
+  uint32_t bits = 0;
+  int pending = 0;  // Bits in the low end of bits not yet written
+  int out = 1;
+  for (int i = 0; i < GF31_POINTS; i++) {
+    bits = (bits << GF31_SYMBOL_BITS) | (symbols[i] & 0x1F);
+    pending += GF31_SYMBOL_BITS;
+    while (pending >= 8) {
+      pending -= 8;
+      frame[out++] = (uint8_t)(bits >> pending);
+    }
+  }
+  if (pending > 0) frame[out] = (uint8_t)(bits << (8 - pending));
+}
+
+// Symbols of a frame; false (a misaligned or corrupted frame) if it does
+// not start with the sync byte or the padding is not zero
+inline bool gf31_unpack(const uint8_t frame[GF31_FRAME_BYTES],
+                        int symbols[GF31_POINTS]) {
+  if (frame[0] != GF31_SYNC_BYTE) return false;
+  uint32_t bits = 0;
+  int pending = 0;  // Bits in the low end of bits not yet read
+  int in = 1;
+  for (int i = 0; i < GF31_POINTS; i++) {
+    if (pending < GF31_SYMBOL_BITS) {
+      bits = (bits << 8) | frame[in++];
+      pending += 8;
+    }
+    pending -= GF31_SYMBOL_BITS;
+    symbols[i] = (int)((bits >> pending) & 0x1F);
+  }
+  return (bits & ((1u << pending) - 1)) == 0;
+}
+
+// Byte-stream parser with resynchronization: a frame is accepted when the
+// last GF31_FRAME_BYTES bytes unpack, and the next one starts after it.
+// After a lost or corrupted byte the window slides one byte at a time
+// until a sync byte lines up with a valid frame again, so only the frames
+// the bad byte touched are lost.
+struct GF31FrameParser {
+  uint8_t window[GF31_FRAME_BYTES];
+  int filled = 0;
+
+  // Feed one received byte; true when it completes a frame, whose symbols
+  // are then in symbols
+  bool push(uint8_t byte, int symbols[GF31_POINTS]) {
+    if (filled == GF31_FRAME_BYTES) {
+      for (int i = 1; i < GF31_FRAME_BYTES; i++) window[i - 1] = window[i];
+      filled--;
+    }
+    window[filled++] = byte;
+    if (filled < GF31_FRAME_BYTES || !gf31_unpack(window, symbols)) {
+      return false;
+    }
+    filled = 0;
+    return true;
+  }
+};
@@ -0,0 +1,759 @@
+#pragma once
+#include <stdint.h>
+
+// Fields up to this prime multiply and invert through tables in flash
+// (P * (P + 1) bytes); larger ones use Barrett reduction. 0 disables
+// the tables.
+#ifndef RS_TABLE_MAX_P
+#define RS_TABLE_MAX_P 64
+#endif
+
+// Codes whose inverse Vandermonde matrices for all K-subsets of the points
+// x = 0..N-1 fit in this many bytes of flash keep them precomputed; 0
+// disables them.
+#ifndef RS_VANDERMONDE_MAX_BYTES
+#define RS_VANDERMONDE_MAX_BYTES 1024
+#endif
+
+// Codes over primes with a P * P single-error syndrome table of at most
+// this many bytes (two per entry) decode clean and single-error words
+// from their syndromes; 0 disables the table.
+#ifndef RS_SYNDROME_MAX_BYTES
+#define RS_SYNDROME_MAX_BYTES 2048
+#endif
+
+#if defined(ARDUINO)
+#include <Arduino.h>  // PROGMEM, pgm_read_byte
+#define RS_FLASH PROGMEM
+#define RS_READ_BYTE(addr) pgm_read_byte(addr)
+#define RS_READ_WORD(addr) pgm_read_word(addr)
+#else
+#define RS_FLASH
+#define RS_READ_BYTE(addr) (*(const uint8_t *)(addr))
+#define RS_READ_WORD(addr) (*(const uint16_t *)(addr))
+#endif
+
+// Reed-Solomon codes over a prime field GF(P), header only and without
+// global state. A message is a polynomial f of degree < K (coefficients
+// lowest power first) sent as its values at N distinct points of GF(P).
+// All buffers are sized at compile time, so loops over N and K have
+// constant bounds and small codes unroll completely.
+
+namespace rs_detail {
+
+constexpr bool is_prime_from(int p, int d) {
+  return d * d > p ? true : (p % d == 0 ? false : is_prime_from(p, d + 1));
+}
+
+constexpr bool is_prime(int p) { return p >= 2 && is_prime_from(p, 2); }
+
+constexpr long long binomial(int n, int k) {
+  return k == 0 ? 1 : binomial(n - 1, k - 1) * n / k;
+}
+
+constexpr int mod_pow(long long base, int exp, int p) {
+  long long res = 1;
+  for (; exp > 0; exp >>= 1) {
+    if (exp & 1) res = res * base % p;
+    base = base * base % p;
+  }
+  return (int)res;
+}
+
+}  // namespace rs_detail
+
+// Multiplication and inverse tables of GF(P), built at compile time
+template <int P>
+struct PrimeTables {
+  static_assert(P <= 256, "table entries are bytes (lower RS_TABLE_MAX_P)");
+
+  uint8_t mul[P][P];
+  uint8_t inv[P];  // inv[0] = 0
+
+  constexpr PrimeTables() : mul(), inv() {
+    for (int a = 0; a < P; a++) {
+      for (int b = 0; b < P; b++) {
+        mul[a][b] = (uint8_t)(a * b % P);
+        if (a * b % P == 1) inv[a] = (uint8_t)b;
+      }
+    }
+  }
+
+  static const PrimeTables instance;
+};
+
+// constexpr: the tables are built by the compiler, and a constructor that
+// is not a constant expression fails the build instead of leaving startup
+// code to fill flash. The same holds for the tables below.
+template <int P>
+constexpr PrimeTables<P> PrimeTables<P>::instance RS_FLASH = PrimeTables<P>();
+
+// Arithmetic in GF(P). Operands must be reduced (0..P-1).
+template <int P>
+struct PrimeField {
+  static_assert(rs_detail::is_prime(P), "GF(P) needs a prime P");
+  static_assert(P < 65536, "products must fit in 32 bits");
+
+  static constexpr bool use_tables = P <= RS_TABLE_MAX_P;
+
+  // Barrett constant floor(2^32 / P)
+  static constexpr uint64_t barrett = (uint64_t(1) << 32) / P;
+
+  // Number of unreduced products (a * b, both reduced) that can be summed
+  // in 32 bits before reduce() is needed
+  static constexpr uint32_t lazy_terms =
+      P == 2 ? 0xFFFFFFFFu : 0xFFFFFFFFu / ((uint32_t)(P - 1) * (P - 1));
+
+  // x mod P for any 32-bit x, without a division: the Barrett quotient is
+  // at most one too small
+  static int reduce(uint32_t x) {
+    uint32_t q = (uint32_t)((x * barrett) >> 32);
+    uint32_t r = x - q * (uint32_t)P;
+    return (int)(r >= (uint32_t)P ? r - P : r);
+  }
+
+  static int add(int a, int b) {
+    int r = a + b;
+    return r >= P ? r - P : r;
+  }
+
+  static int sub(int a, int b) {
+    int r = a - b;
+    return r < 0 ? r + P : r;
+  }
+
+  static int mul(int a, int b) {
+    if constexpr (use_tables) {
+      return RS_READ_BYTE(&PrimeTables<P>::instance.mul[a][b]);
+    } else {
+      return reduce((uint32_t)a * b);
+    }
+  }
+
+  // base^exp for exp >= 0
+  static int pow(int base, int exp) {
+    int res = 1;
+    while (exp > 0) {
+      if (exp & 1) res = mul(res, base);
+      base = mul(base, base);
+      exp >>= 1;
+    }
+    return res;
+  }
+
+  // a^-1 for a != 0 (table, or a^(P-2) by Fermat)
+  static int inv(int a) {
+    if constexpr (use_tables) {
+      return RS_READ_BYTE(&PrimeTables<P>::instance.inv[a]);
+    } else {
+      return pow(a, P - 2);
+    }
+  }
+};
+
+// Polynomials over GF(P) in arrays of SIZE coefficients, lowest power
+// first. Degree -1 is the zero polynomial.
+template <int P, int SIZE>
+struct PrimePoly {
+  typedef PrimeField<P> Field;
+
+  // Degree of p (highest nonzero coefficient below size), -1 for p = 0
+  static int degree(const int p[], int size) {
+    int deg = size - 1;
+    while (deg >= 0 && p[deg] == 0) deg--;
+    return deg;
+  }
+
+  // p(x) as sum p[i] * x^i, reduced once when the sum fits in 32 bits
+  static int eval(const int p[], int deg, int x) {
+    if (deg < 0) return 0;
+    bool lazy = (uint32_t)deg < Field::lazy_terms;
+    uint32_t sum = (uint32_t)p[0];
+    int power = 1;
+    for (int i = 1; i <= deg; i++) {
+      power = Field::mul(power, x);
+      sum += (uint32_t)p[i] * power;
+      if (!lazy) sum = Field::reduce(sum);
+    }
+    return Field::reduce(sum);
+  }
+
+  // a = q * b + r with deg r < deg b (b != 0). q and r are SIZE arrays;
+  // r may be a.
+  static void divmod(const int a[], int deg_a, const int b[], int deg_b,
+                     int q[], int r[]) {
+    int rem[SIZE];
+    for (int i = 0; i < SIZE; i++) {
+      rem[i] = i <= deg_a ? a[i] : 0;
+      q[i] = 0;
+    }
+
+    int lead_inv = Field::inv(b[deg_b]);
+    for (int i = deg_a - deg_b; i >= 0; i--) {
+      int c = Field::mul(rem[i + deg_b], lead_inv);
+      q[i] = c;
+      if (c == 0) continue;
+      for (int j = 0; j <= deg_b; j++) {
+        rem[i + j] = Field::sub(rem[i + j], Field::mul(c, b[j]));
+      }
+    }
+    for (int i = 0; i < SIZE; i++) r[i] = rem[i];
+  }
+
+  // Gao's decoder (partial extended Euclid on the interpolation
+  // polynomial) for n <= SIZE - 1 points and k message coefficients:
+  // corrects up to (n - k) / 2 wrong y values in O(n^2).
+  //
+  // coeffs:    Output, k coefficients of f
+  // error_idx: Optional output (may be nullptr, else room for n entries),
+  //            indices i of the corrected points
+  // Returns the number of corrected errors, or -1 if the points are not
+  // within (n - k) / 2 errors of any codeword (or the input is invalid)
+  static int gao(const int x[], const int y[], int n, int k, int coeffs[],
+                 int error_idx[]) {
+    if (k < 1 || n < k || n > SIZE - 1 || n > P) return -1;
+    for (int i = 0; i < n; i++) {
+      if (x[i] < 0 || x[i] >= P) return -1;
+      for (int j = 0; j < i; j++) {
+        if (x[i] == x[j]) return -1;  // Points must be distinct
+      }
+    }
+
+    // g0(x) = prod (x - x_i)
+    int g0[SIZE] = {1};
+    for (int i = 0; i < n; i++) {
+      for (int a = i + 1; a > 0; a--) {
+        g0[a] = Field::sub(g0[a - 1], Field::mul(g0[a], x[i]));
+      }
+      g0[0] = Field::sub(0, Field::mul(g0[0], x[i]));
+    }
+
+    // g1(x) = sum y_i * g0(x) / ((x - x_i) * g0'(x_i)), the interpolation
+    // polynomial of degree < n. g0 / (x - x_i) by synthetic division.
+    int g1[SIZE] = {0};
+    for (int i = 0; i < n; i++) {
+      if (y[i] == 0) continue;
+      int basis[SIZE];
+      basis[n - 1] = g0[n];
+      for (int a = n - 1; a > 0; a--) {
+        basis[a - 1] = Field::add(g0[a], Field::mul(basis[a], x[i]));
+      }
+      int scalar = Field::mul(y[i], Field::inv(eval(basis, n - 1, x[i])));
+      for (int a = 0; a < n; a++) {
+        g1[a] = Field::add(g1[a], Field::mul(basis[a], scalar));
+      }
+    }
+
+    // Extended Euclid on (g0, g1) until deg r < (n + k) / 2, tracking only
+    // the cofactor v of g1: r = u * g0 + v * g1
+    int r0[SIZE], r1[SIZE], v0[SIZE], v1[SIZE];
+    for (int i = 0; i < SIZE; i++) {
+      r0[i] = g0[i];
+      r1[i] = g1[i];
+      v0[i] = 0;
+      v1[i] = i == 0 ? 1 : 0;
+    }
+    int deg_r0 = n;
+    int deg_r1 = degree(r1, n);
+    int deg_v1 = 0;
+    while (2 * deg_r1 >= n + k) {
+      int q[SIZE];
+      divmod(r0, deg_r0, r1, deg_r1, q, r0);
+      int deg_q = deg_r0 - deg_r1;
+
+      // (r0, r1) = (r1, r0 mod r1), (v0, v1) = (v1, v0 - q * v1)
+      for (int a = 0; a <= deg_q; a++) {
+        if (q[a] == 0) continue;
+        for (int b = 0; b <= deg_v1; b++) {
+          v0[a + b] = Field::sub(v0[a + b], Field::mul(q[a], v1[b]));
+        }
+      }
+      for (int i = 0; i < SIZE; i++) {
+        int t = r0[i];
+        r0[i] = r1[i];
+        r1[i] = t;
+        t = v0[i];
+        v0[i] = v1[i];
+        v1[i] = t;
+      }
+      deg_r0 = deg_r1;
+      deg_r1 = degree(r1, deg_r0);
+      deg_v1 = degree(v1, SIZE);
+    }
+
+    // f = r1 / v1 (v1 is the error locator), exact with deg f < k
+    int f[SIZE], rem[SIZE];
+    if (deg_r1 < 0) {
+      for (int i = 0; i < SIZE; i++) f[i] = rem[i] = 0;
+    } else {
+      divmod(r1, deg_r1, v1, deg_v1, f, rem);
+    }
+    if (degree(rem, SIZE) >= 0 || degree(f, SIZE) >= k) return -1;
+
+    for (int i = 0; i < k; i++) coeffs[i] = f[i];
+    int errors = 0;
+    for (int i = 0; i < n; i++) {
+      if (eval(f, k - 1, x[i]) != y[i]) {
+        if (error_idx) error_idx[errors] = i;
+        errors++;
+      }
+    }
+    return 2 * errors <= n - k ? errors : -1;
+  }
+};
+
+// Inverse Vandermonde matrices of GF(P), P <= 256, for every K-subset of
+// the points x = 0..N-1, built at compile time. Column x of
+// coef[subset[mask]] holds the coefficients of the Lagrange basis
+// polynomial of x (zero for x not in mask), so interpolating through the
+// points in mask is coeffs[a] = sum coef[s][a][x_i] * y_i.
+template <int P, int N, int K>
+struct VandermondeTables {
+  static constexpr int subsets = (int)rs_detail::binomial(N, K);
+  static_assert(P <= 256 && subsets <= 256, "entries must fit in bytes");
+
+  uint8_t subset[1 << N];  // Mask of K points to subset index
+  uint8_t coef[subsets][K][N];
+
+  constexpr VandermondeTables() : subset(), coef() {
+    int s = 0;
+    for (int mask = 0; mask < (1 << N); mask++) {
+      int members = 0;
+      for (int x = 0; x < N; x++) members += (mask >> x) & 1;
+      if (members != K) continue;
+      subset[mask] = (uint8_t)s;
+
+      for (int x = 0; x < N; x++) {
+        if (!((mask >> x) & 1)) continue;
+        // L_x = prod (X - m) / prod (x - m) over the other members m
+        int li[K + 1] = {1};
+        int li_size = 1;
+        int denom = 1;
+        for (int m = 0; m < N; m++) {
+          if (m == x || !((mask >> m) & 1)) continue;
+          for (int a = li_size; a > 0; a--) {
+            li[a] = (li[a - 1] + (P - m % P) * li[a]) % P;
+          }
+          li[0] = (P - m % P) * li[0] % P;
+          li_size++;
+          denom = denom * ((x - m + P) % P) % P;
+        }
+        int inv = rs_detail::mod_pow(denom, P - 2, P);
+        for (int a = 0; a < K; a++) coef[s][a][x] = (uint8_t)(li[a] * inv % P);
+      }
+      s++;
+    }
+  }
+
+  static const VandermondeTables instance;
+};
+
+template <int P, int N, int K>
+constexpr VandermondeTables<P, N, K> VandermondeTables<P, N, K>::instance
+    RS_FLASH = VandermondeTables<P, N, K>();
+
+// Parity-check matrix of RS(N, K) over GF(P), P <= 256, at the points
+// x = 0..N-1, and the single-error table of its first two syndromes, built
+// at compile time. A word y is a codeword iff
+// S_j = sum check[j][x] * y_x = 0 for all j < N - K, with
+// check[j][x] = x^j / prod (x - m) over m != x. An error of value e at x
+// gives S_j = check[j][x] * e, so (S_0, S_1) determines (x, e).
+template <int P, int N, int K>
+struct SyndromeTables {
+  static_assert(P <= 256 && N <= 255 && N - K >= 2,
+                "entries must fit in bytes, two syndromes needed");
+
+  uint8_t check[N - K][N];
+  uint8_t position[P * P];  // x + 1 of the error for S_0 + P * S_1, or 0
+  uint8_t value[P * P];     // Error value e (y = codeword + e)
+
+  constexpr SyndromeTables() : check(), position(), value() {
+    for (int x = 0; x < N; x++) {
+      int denom = 1;
+      for (int m = 0; m < N; m++) {
+        if (m != x) denom = denom * ((x - m + P) % P) % P;
+      }
+      int weight = rs_detail::mod_pow(denom, P - 2, P);
+      for (int j = 0; j < N - K; j++) {
+        check[j][x] = (uint8_t)weight;
+        weight = weight * (x % P) % P;
+      }
+
+      for (int e = 1; e < P; e++) {
+        int index = check[0][x] * e % P + P * (check[1][x] * e % P);
+        position[index] = (uint8_t)(x + 1);
+        value[index] = (uint8_t)e;
+      }
+    }
+  }
+
+  static const SyndromeTables instance;
+};
+
+template <int P, int N, int K>
+constexpr SyndromeTables<P, N, K> SyndromeTables<P, N, K>::instance
+    RS_FLASH = SyndromeTables<P, N, K>();
+
+// Parity rows of the systematic encoder of RS(N, K) over GF(P), built at
+// compile time. The codeword whose values at x = 0..K-1 are the
+// data d has y_j = sum parity[j - K][i] * d_i at x = j >= K, where
+// parity[j - K][i] is the Lagrange basis polynomial of i over 0..K-1 at j.
+template <int P, int N, int K>
+struct ParityTables {
+  static_assert(N > K, "a code without parity has no parity rows");
+
+  uint16_t parity[N - K][K];
+
+  constexpr ParityTables() : parity() {
+    for (int j = K; j < N; j++) {
+      for (int i = 0; i < K; i++) {
+        long long num = 1;
+        long long denom = 1;
+        for (int m = 0; m < K; m++) {
+          if (m == i) continue;
+          num = num * (j - m) % P;
+          denom = denom * ((i - m + P) % P) % P;
+        }
+        parity[j - K][i] =
+            (uint16_t)(num * rs_detail::mod_pow(denom, P - 2, P) % P);
+      }
+    }
+  }
+
+  static const ParityTables instance;
+};
+
+template <int P, int N, int K>
+constexpr ParityTables<P, N, K> ParityTables<P, N, K>::instance RS_FLASH =
+    ParityTables<P, N, K>();
+
+// RS(N, K) over GF(P): K message coefficients, N points, corrects
+// T = (N - K) / 2 wrong values. ReedSolomon<31, 6, 4> is the code of the
+// GF(31) sender and receiver.
+template <int P, int N, int K>
+class ReedSolomon {
+  static_assert(K >= 1 && K <= N, "need 1 <= K <= N");
+  static_assert(N <= P, "N points need N distinct x values in GF(P)");
+
+ public:
+  typedef PrimeField<P> Field;
+  typedef PrimePoly<P, N + 1> Poly;
+
+  static constexpr int p = P;
+  static constexpr int n = N;
+  static constexpr int k = K;
+  static constexpr int t = (N - K) / 2;
+
+  // Sums of K products fit in 32 bits: reduce once per result
+  static constexpr bool lazy = K <= Field::lazy_terms;
+
+  // Interpolation through K of the points x = 0..N-1 uses precomputed
+  // inverse Vandermonde matrices (VandermondeTables)
+  static constexpr bool use_vandermonde =
+      P <= 256 && N <= 16 &&
+      (1 << N) + rs_detail::binomial(N, K) * K * N <=
+          RS_VANDERMONDE_MAX_BYTES;
+
+  // Words at the points x = 0..N-1 (in any order) are checked through
+  // their syndromes and single errors looked up (SyndromeTables)
+  static constexpr bool use_syndromes =
+      P <= 256 && N <= 32 && N - K >= 2 &&
+      2LL * P * P <= RS_SYNDROME_MAX_BYTES;
+
+  // f(x) for a message polynomial f
+  static int evaluate(const int coeffs[K], int x) {
+    uint32_t sum = (uint32_t)coeffs[0];
+    int power = 1;
+    for (int i = 1; i < K; i++) {
+      power = Field::mul(power, x);
+      sum += (uint32_t)coeffs[i] * power;
+      if (!lazy) sum = Field::reduce(sum);
+    }
+    return Field::reduce(sum);
+  }
+
+  // Codeword y[i] = f(i), i.e. the points x = 0..N-1
+  static void encode(const int coeffs[K], int y[N]) {
+    for (int i = 0; i < N; i++) y[i] = evaluate(coeffs, i);
+  }
+
+  // Systematic codeword: y[i] = data[i] for i < K, followed by N - K
+  // parity symbols, the values at x = K..N-1 of the f through the data.
+  // Same code as encode(), so decode() and the rest apply unchanged.
+  static void encode_systematic(const int data[K], int y[N]) {
+    for (int i = 0; i < K; i++) y[i] = data[i];
+    if constexpr (N > K) {
+      typedef ParityTables<P, N, K> Tables;
+      for (int j = K; j < N; j++) {
+        uint32_t sum = 0;
+        for (int i = 0; i < K; i++) {
+          sum += (uint32_t)RS_READ_WORD(&Tables::instance.parity[j - K][i]) *
+                 data[i];
+          if (!lazy) sum = Field::reduce(sum);
+        }
+        y[j] = Field::reduce(sum);
+      }
+    }
+  }
+
+  // Data symbols f(0..K-1) of the systematic codeword of f (data may be
+  // coeffs)
+  static void systematic_data(const int coeffs[K], int data[K]) {
+    int values[K];
+    for (int i = 0; i < K; i++) values[i] = evaluate(coeffs, i);
+    for (int i = 0; i < K; i++) data[i] = values[i];
+  }
+
+  // Lagrange interpolation through count <= K points with distinct x;
+  // coefficients above count - 1 are zero
+  static void interpolate(const int x[], const int y[], int count,
+                          int coeffs[K]) {
+    if constexpr (use_vandermonde) {
+      if (count == K && interpolate_standard(x, y, coeffs)) return;
+    }
+
+    // Denominators prod (x_i - x_j), inverted together: one inversion and
+    // 3 (count - 1) multiplications (Montgomery's trick)
+    int denom[K], prefix[K];
+    int running = 1;
+    for (int i = 0; i < count; i++) {
+      denom[i] = 1;
+      for (int j = 0; j < count; j++) {
+        if (j != i) denom[i] = Field::mul(denom[i], Field::sub(x[i], x[j]));
+      }
+      prefix[i] = running;
+      running = Field::mul(running, denom[i]);
+    }
+    int inv_running = Field::inv(running);
+
+    uint32_t sums[K] = {0};
+    for (int i = count - 1; i >= 0; i--) {
+      int inv_denom = Field::mul(inv_running, prefix[i]);
+      inv_running = Field::mul(inv_running, denom[i]);
+
+      int li[K + 1] = {1};  // L_i(x) = prod (x - x_j)
+      int li_size = 1;
+      for (int j = 0; j < count; j++) {
+        if (j == i) continue;
+        for (int a = li_size; a > 0; a--) {
+          li[a] = Field::sub(li[a - 1], Field::mul(li[a], x[j]));
+        }
+        li[0] = Field::sub(0, Field::mul(li[0], x[j]));
+        li_size++;
+      }
+
+      int scalar = Field::mul(y[i], inv_denom);
+      for (int a = 0; a < li_size; a++) {
+        sums[a] += (uint32_t)li[a] * scalar;
+        if (!lazy) sums[a] = Field::reduce(sums[a]);
+      }
+    }
+    for (int a = 0; a < K; a++) coeffs[a] = Field::reduce(sums[a]);
+  }
+
+  // True if all count points lie on f
+  static bool verify(const int x[], const int y[], int count,
+                     const int coeffs[K]) {
+    for (int i = 0; i < count; i++) {
+      if (evaluate(coeffs, x[i]) != y[i]) return false;
+    }
+    return true;
+  }
+
+  // Syndromes S_j (j < N - K) of a word at the points x = 0..N-1 in any
+  // order: all zero iff the word is a codeword. O(N * (N - K)).
+  // Returns false (nothing written) if x is not a permutation of 0..N-1
+  // or the code has no syndrome tables
+  static bool syndromes(const int x[N], const int y[N], int s[]) {
+    if constexpr (use_syndromes) {
+      typedef SyndromeTables<P, N, K> Tables;
+      uint32_t mask = 0;
+      for (int i = 0; i < N; i++) {
+        if (x[i] < 0 || x[i] >= N || ((mask >> x[i]) & 1)) return false;
+        mask |= (uint32_t)1 << x[i];
+      }
+      for (int j = 0; j < N - K; j++) {
+        uint32_t sum = 0;  // N products below 2^16 each
+        for (int i = 0; i < N; i++) {
+          sum += (uint32_t)RS_READ_BYTE(&Tables::instance.check[j][x[i]]) *
+                 y[i];
+        }
+        s[j] = Field::reduce(sum);
+      }
+      return true;
+    } else {
+      (void)x, (void)y, (void)s;
+      return false;
+    }
+  }
+
+  // Decode N received points: a clean word is recognized from the
+  // syndromes or the first K points, a single error from the syndromes,
+  // anything else goes through Gao's decoder.
+  // error_idx: Optional output (nullptr or room for N entries), indices of
+  //            the corrected points
+  // Returns the number of corrected errors, or -1 if there are more than T
+  static int decode(const int x[N], const int y[N], int coeffs[K],
+                    int error_idx[]) {
+    if constexpr (use_syndromes) {
+      int fixed[N];
+      int errors = correct_syndromes(x, y, fixed, error_idx);
+      if (errors >= 0) interpolate(x, fixed, K, coeffs);
+      if (errors != -2) return errors;
+    }
+    return decode_general(x, y, coeffs, error_idx);
+  }
+
+  // decode() for systematic codewords (encode_systematic): data receives
+  // the K data symbols. Clean and single-error words are read off the
+  // syndrome-corrected word without any interpolation.
+  static int decode_systematic(const int x[N], const int y[N], int data[K],
+                               int error_idx[]) {
+    if constexpr (use_syndromes) {
+      int fixed[N];
+      int errors = correct_syndromes(x, y, fixed, error_idx);
+      if (errors >= 0) {
+        for (int i = 0; i < N; i++) {
+          if (x[i] < K) data[x[i]] = fixed[i];
+        }
+      }
+      if (errors != -2) return errors;
+    }
+    int errors = decode_general(x, y, data, error_idx);
+    if (errors >= 0) systematic_data(data, data);
+    return errors;
+  }
+
+  // Errors-and-erasures decoding of count received points whose x should
+  // be the positions 0..N-1, e.g. after x itself was corrupted. Positions
+  // that no point or several points claim are the s erasures; points with
+  // x outside 0..N-1 are dropped. The N - s uniquely held positions are
+  // decoded with up to e wrong y values, 2e + s <= N - K, in one pass.
+  // Each dropped point (duplicate or out of range) must then lie on f at
+  // one of the erased positions, which catches words that leave no
+  // redundancy to check (s = N - K).
+  // error_idx: Optional output (nullptr or room for N entries), indices of
+  //            the corrected points
+  // Returns the number of corrected errors, or -1 if the points are not
+  // within the budget (or not consistent with the decoded f)
+  static int decode_erasures(const int x[], const int y[], int count,
+                             int coeffs[K], int error_idx[]) {
+    // holder[p]: index of the only point at position p, -1 for none, -2
+    // for several
+    int holder[N];
+    for (int p = 0; p < N; p++) holder[p] = -1;
+    for (int i = 0; i < count; i++) {
+      if (x[i] < 0 || x[i] >= N) continue;
+      holder[x[i]] = holder[x[i]] == -1 ? i : -2;
+    }
+
+    int kept_x[N], kept_y[N], kept_idx[N];
+    int kept = 0;
+    for (int p = 0; p < N; p++) {
+      if (holder[p] < 0) continue;
+      kept_x[kept] = p;
+      kept_y[kept] = y[holder[p]];
+      kept_idx[kept] = holder[p];
+      kept++;
+    }
+    if (kept < K) return -1;  // More than N - K erasures
+
+    // No redundancy left (kept == K): f is the interpolant, checked by the
+    // dropped points below
+    int wrong[N];
+    int errors = 0;
+    if (kept == N) {
+      errors = decode(kept_x, kept_y, coeffs, wrong);
+    } else if (kept == K) {
+      interpolate(kept_x, kept_y, K, coeffs);
+    } else {
+      errors = Poly::gao(kept_x, kept_y, kept, K, coeffs, wrong);
+    }
+    if (errors < 0) return -1;
+
+    int erased[N];  // f at the erased positions
+    for (int p = 0; p < N; p++) {
+      erased[p] = holder[p] < 0 ? evaluate(coeffs, p) : -1;
+    }
+    for (int i = 0; i < count; i++) {
+      if (x[i] >= 0 && x[i] < N && holder[x[i]] == i) continue;
+      bool fits = false;
+      for (int p = 0; p < N && !fits; p++) fits = erased[p] == y[i];
+      if (!fits) return -1;
+    }
+
+    if (error_idx) {
+      for (int j = 0; j < errors; j++) error_idx[j] = kept_idx[wrong[j]];
+    }
+    return errors;
+  }
+
+ private:
+  // Decoding without syndromes: a clean word is recognized from the first
+  // K points, anything else goes through Gao's decoder
+  static int decode_general(const int x[N], const int y[N], int coeffs[K],
+                            int error_idx[]) {
+    interpolate(x, y, K, coeffs);
+    if (verify(x, y, N, coeffs)) return 0;
+    return Poly::gao(x, y, N, K, coeffs, error_idx);
+  }
+
+  // Syndrome decoding of words at the points x = 0..N-1: fixed receives
+  // the codeword for 0 or 1 errors, at the cost of one syndrome
+  // computation. Returns the number of corrected errors, -1 for more than
+  // T, or -2 if the word needs the general decoder (other x, or T > 1 and
+  // more than one error)
+  static int correct_syndromes(const int x[N], const int y[N], int fixed[N],
+                               int error_idx[]) {
+    typedef SyndromeTables<P, N, K> Tables;
+    int s[N - K];
+    if (!syndromes(x, y, s)) return -2;
+
+    for (int a = 0; a < N; a++) fixed[a] = y[a];
+    bool clean = true;
+    for (int j = 0; j < N - K; j++) clean = clean && s[j] == 0;
+    if (clean) return 0;
+
+    // Single error at position: S_j = S_0 * position^j for every j
+    int index = s[0] + P * s[1];
+    int position = RS_READ_BYTE(&Tables::instance.position[index]) - 1;
+    bool single = position >= 0;
+    int expected = s[1];
+    for (int j = 2; single && j < N - K; j++) {
+      expected = Field::mul(expected, position);
+      single = s[j] == expected;
+    }
+    if (!single) return t == 1 ? -1 : -2;
+
+    int i = 0;
+    while (x[i] != position) i++;
+    fixed[i] = Field::sub(y[i],
+                          RS_READ_BYTE(&Tables::instance.value[index]));
+    if (error_idx) error_idx[0] = i;
+    return 1;
+  }
+
+  // Interpolation through K distinct points of x = 0..N-1 as one matrix
+  // product: K * K multiplications and K reductions, no inversion.
+  // Returns false (nothing written) for any other x.
+  static bool interpolate_standard(const int x[], const int y[],
+                                   int coeffs[K]) {
+    typedef VandermondeTables<P, N, K> Tables;
+    unsigned mask = 0;
+    for (int i = 0; i < K; i++) {
+      if (x[i] < 0 || x[i] >= N || ((mask >> x[i]) & 1)) return false;
+      mask |= 1u << x[i];
+    }
+
+    const uint8_t(*coef)[N] =
+        Tables::instance.coef[RS_READ_BYTE(&Tables::instance.subset[mask])];
+    for (int a = 0; a < K; a++) {
+      uint32_t sum = 0;  // K products below 2^16 each
+      for (int i = 0; i < K; i++) {
+        sum += (uint32_t)RS_READ_BYTE(&coef[a][x[i]]) * y[i];
+      }
+      coeffs[a] = Field::reduce(sum);
+    }
+    return true;
+  }
+};
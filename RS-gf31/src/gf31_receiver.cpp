@@ -2,6 +2,23 @@
 #include <SoftwareSerial.h>
 
 #include "gf31_math.hpp"
+#include "gf31_protocol.hpp"
+#include "reed_solomon.hpp"
+
+// Points per message, x = 0..NUM_POINTS-1
+#define NUM_POINTS GF31_POINTS
+
+// RS(6, 4) over GF(31): corrects 1 wrong y value
+typedef ReedSolomon<MOD, NUM_POINTS, MAX_COEFFS> GF31Code;
+
+// reed_solomon_decode: 1 = Gao's algebraic decoder, corrects (n - 4) / 2
+// errors for any number of points; 0 = drop-one-point search (1 error)
+#define USE_GAO_DECODER 1
+
+// tryDecodeWithDuplicates: 1 = errors-and-erasures decoding (duplicated,
+// missing and out of range x are erasures, one pass); 0 = try every
+// combination of the duplicated points
+#define USE_ERASURE_DECODER 1
 
 SoftwareSerial softSerial(13, 12);  // RX, TX
 
@@ -9,11 +26,20 @@ struct Point {
     int x;
     int y;
 };
-Point points[6];
+Point points[NUM_POINTS];
 int count = 0;
-int original_data[MAX_COEFFS];  // Original data coefficients
+int original_data[MAX_COEFFS];  // Sent coefficients (data symbols)
 int data_count = 0;
 
+#if GF31_COMPACT_PROTOCOL
+GF31FrameParser parser;
+#endif
+
+#if !GF31_RAW_DATA
+// The message is not sent in the clear; compare against the known one
+const int test_message[MAX_COEFFS] = GF31_TEST_MESSAGE;
+#endif
+
 // Statistics
 int total_transmissions = 0;
 int clean_transmissions = 0;      // No errors
@@ -25,7 +51,7 @@ int incorrect_corrections = 0;    // Corrected but to wrong data
 // Store one example of incorrect correction
 bool has_incorrect_example = false;
 int example_original[MAX_COEFFS];
-Point example_points[6];
+Point example_points[NUM_POINTS];
 int example_decoded[MAX_COEFFS];
 
 const int MESSAGES_PER_TEST = 1000;
@@ -123,7 +149,7 @@ void print_test_summary() {
         Serial.println("]");
 
         Serial.println("  Received points:");
-        for (int i = 0; i < 6; i++) {
+        for (int i = 0; i < NUM_POINTS; i++) {
             Serial.print("    (");
             Serial.print(example_points[i].x);
             Serial.print(", ");
@@ -158,7 +184,7 @@ void print_test_summary() {
 }
 
 // Validate x coordinate range
-bool is_valid_x(int x) { return (x >= 0 && x <= 5); }
+bool is_valid_x(int x) { return (x >= 0 && x < NUM_POINTS); }
 
 // Validate y coordinate range
 bool is_valid_y(int y) {
@@ -181,13 +207,23 @@ bool hasDuplicateX(Point *pts, int n) {
     return false;
 }
 
+// Check if any x value is out of range
+bool hasInvalidX(Point *pts, int n) {
+    for (int i = 0; i < n; i++) {
+        if (!is_valid_x(pts[i].x)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Count occurrences of each x value
 void analyzeXDistribution(Point *pts, int n) {
-    int x_count[6] = {0, 0, 0, 0, 0, 0};
+    int x_count[NUM_POINTS] = {0};
     int out_of_range = 0;
 
     for (int i = 0; i < n; i++) {
-        if (pts[i].x >= 0 && pts[i].x <= 5) {
+        if (pts[i].x >= 0 && pts[i].x < NUM_POINTS) {
             x_count[pts[i].x]++;
         } else {
             out_of_range++;
@@ -217,15 +253,31 @@ int selectUniquePoints(Point *pts, int n, Point *unique_pts) {
     return unique_count;
 }
 
+#if USE_ERASURE_DECODER
+// Decode with duplicate or out of range x: x values held by no point or by
+// several points are erasures, the rest is corrected within 2e + s <= 2
+bool tryDecodeWithDuplicates(Point *pts, int n, int decoded_coeffs[]) {
+    int xs[NUM_POINTS], ys[NUM_POINTS];
+    if (n > NUM_POINTS) {
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        xs[i] = is_valid_x(pts[i].x) ? pts[i].x : -1;
+        ys[i] = pts[i].y >= MOD ? pts[i].y - MOD : pts[i].y;
+    }
+    return GF31Code::decode_erasures(xs, ys, n, decoded_coeffs, nullptr) >= 0;
+}
+#else
 // Try to decode with duplicate x by trying different point combinations
 bool tryDecodeWithDuplicates(Point *pts, int n, int decoded_coeffs[]) {
     // Find which x values are duplicated
-    int x_occurrences[6][6];  // x_occurrences[x][i] = index in pts array
-    int x_counts[6] = {0, 0, 0, 0, 0, 0};
+    // x_occurrences[x][i] = index in pts array
+    int x_occurrences[NUM_POINTS][NUM_POINTS];
+    int x_counts[NUM_POINTS] = {0};
 
     for (int i = 0; i < n; i++) {
         int x = pts[i].x;
-        if (x >= 0 && x <= 5) {
+        if (x >= 0 && x < NUM_POINTS) {
             x_occurrences[x][x_counts[x]] = i;
             x_counts[x]++;
         }
@@ -233,7 +285,7 @@ bool tryDecodeWithDuplicates(Point *pts, int n, int decoded_coeffs[]) {
 
     // Count total combinations to try
     int total_combinations = 1;
-    for (int x = 0; x < 6; x++) {
+    for (int x = 0; x < NUM_POINTS; x++) {
         if (x_counts[x] > 1) {
             total_combinations *= x_counts[x];
         }
@@ -241,12 +293,12 @@ bool tryDecodeWithDuplicates(Point *pts, int n, int decoded_coeffs[]) {
 
     // Try each combination
     for (int combo = 0; combo < total_combinations; combo++) {
-        Point test_points[6];
+        Point test_points[NUM_POINTS];
         int test_count = 0;
         int combo_temp = combo;
 
         // Select one point for each x value
-        for (int x = 0; x < 6; x++) {
+        for (int x = 0; x < NUM_POINTS; x++) {
             if (x_counts[x] > 0) {
                 int which_occurrence = 0;
                 if (x_counts[x] > 1) {
@@ -272,51 +324,33 @@ bool tryDecodeWithDuplicates(Point *pts, int n, int decoded_coeffs[]) {
 
     return false;  // All combinations failed
 }
+#endif
 
+// Interpolate the polynomial through n <= MAX_COEFFS points. Four distinct
+// x in 0..NUM_POINTS-1 take a precomputed inverse Vandermonde matrix.
 void lagrange_interpolate(Point *pts, int n, int coeffs[]) {
-    for (int i = 0; i < n; i++) coeffs[i] = 0;
-
+    int xs[MAX_COEFFS], ys[MAX_COEFFS];
     for (int i = 0; i < n; i++) {
-        int Li_coeffs[MAX_COEFFS] = {1, 0, 0, 0};
-        int Li_size = 1;
-        int denom = 1;
-
-        for (int j = 0; j < n; j++) {
-            if (j == i) continue;
-
-            int xj = pts[j].x;
-            int xi = pts[i].x;
-
-            int newLi[MAX_COEFFS] = {0, 0, 0, 0};
-            for (int a = 0; a < Li_size; a++) {
-                newLi[a] = gf_add(newLi[a], gf_mul(Li_coeffs[a], MOD - xj));
-                newLi[a + 1] = gf_add(newLi[a + 1], Li_coeffs[a]);
-            }
-            for (int a = 0; a <= Li_size; a++) Li_coeffs[a] = newLi[a];
-            Li_size++;
-
-            denom = gf_mul(denom, gf_add(xi, MOD - xj));
-        }
-
-        int inv_denom = gf_inv(denom);
-        int scalar = gf_mul(pts[i].y, inv_denom);
-        for (int a = 0; a < Li_size; a++) {
-            coeffs[a] = gf_add(coeffs[a], gf_mul(Li_coeffs[a], scalar));
-        }
+        xs[i] = pts[i].x;
+        // A 5-bit y of 31 is 0 in GF(31)
+        ys[i] = pts[i].y >= MOD ? pts[i].y - MOD : pts[i].y;
     }
+    GF31Code::interpolate(xs, ys, n, coeffs);
+}
+
+// The decoders report the message in the form it was sent: with
+// GF31_SYSTEMATIC the data symbols f(0..3), otherwise the coefficients
+void coeffs_to_message(int coeffs[]) {
+#if GF31_SYSTEMATIC
+    GF31Code::systematic_data(coeffs, coeffs);
+#else
+    (void)coeffs;
+#endif
 }
 
 // Calculate polynomial value at point x
 int evaluate_polynomial(int coeffs[], int degree, int x) {
-    int result = 0;
-    int x_power = 1;
-
-    for (int i = 0; i <= degree; i++) {
-        result = gf_add(result, gf_mul(coeffs[i], x_power));
-        x_power = gf_mul(x_power, x);
-    }
-
-    return result;
+    return GF31Code::Poly::eval(coeffs, degree, x);
 }
 
 // Check if all points fit the polynomial
@@ -340,7 +374,9 @@ void copy_points_except(Point *src, int n, Point *dst, int skip_idx) {
     }
 }
 
-// Main Reed-Solomon error correction function
+// Main Reed-Solomon error correction function. Returns the number of
+// corrected errors (*error_idx = first corrected point), or one more than
+// the correctable number when decoding fails
 int reed_solomon_decode(Point *pts, int n, int coeffs[], int *error_idx) {
     // n = 6 points, need 4 for interpolation (degree 3 polynomial)
     // We have 2 redundant points - can correct 1 error
@@ -349,11 +385,43 @@ int reed_solomon_decode(Point *pts, int n, int coeffs[], int *error_idx) {
         return -1;  // Not enough points
     }
 
+#if USE_GAO_DECODER
+    if (n != NUM_POINTS) {
+        return -1;  // The code is RS(NUM_POINTS, MAX_COEFFS)
+    }
+
+    int xs[NUM_POINTS], ys[NUM_POINTS], error_positions[NUM_POINTS];
+    for (int i = 0; i < n; i++) {
+        xs[i] = pts[i].x;
+        ys[i] = pts[i].y >= MOD ? pts[i].y - MOD : pts[i].y;
+    }
+#if GF31_SYSTEMATIC
+    // Data read off the corrected word, no interpolation on the syndrome
+    // path
+    int errors = GF31Code::decode_systematic(xs, ys, coeffs, error_positions);
+#else
+    int errors = GF31Code::decode(xs, ys, coeffs, error_positions);
+#endif
+    if (errors == 0) {
+        clean_transmissions++;
+        return 0;  // No errors
+    }
+    if (errors > 0) {
+        *error_idx = error_positions[0];
+        corrected_transmissions++;
+        return errors;
+    }
+
+    // More errors than the redundant points can correct
+    failed_corrections++;
+    return GF31Code::t + 1;
+#else
     // Step 1: Try interpolation with first 4 points
     lagrange_interpolate(pts, 4, coeffs);
 
     // Step 2: Check if all points fit the polynomial
     if (verify_points(pts, n, coeffs, 3)) {
+        coeffs_to_message(coeffs);
         clean_transmissions++;
         return 0;  // No errors
     }
@@ -361,7 +429,7 @@ int reed_solomon_decode(Point *pts, int n, int coeffs[], int *error_idx) {
     // Step 3: There are errors - try to find 1 erroneous point
     // Test all combinations excluding 1 point at a time
     for (int skip = 0; skip < n; skip++) {
-        Point test_points[6];
+        Point test_points[NUM_POINTS];
         copy_points_except(pts, n, test_points, skip);
 
         // Interpolate with 5 points (using first 4)
@@ -374,6 +442,7 @@ int reed_solomon_decode(Point *pts, int n, int coeffs[], int *error_idx) {
             for (int i = 0; i < MAX_COEFFS; i++) {
                 coeffs[i] = test_coeffs[i];
             }
+            coeffs_to_message(coeffs);
 
             *error_idx = skip;
             corrected_transmissions++;
@@ -384,6 +453,7 @@ int reed_solomon_decode(Point *pts, int n, int coeffs[], int *error_idx) {
     // Step 4: Could not find 1 erroneous point - we have 2 or more errors
     failed_corrections++;
     return 2;  // 2 or more errors
+#endif
 }
 
 void setup() {
@@ -391,6 +461,12 @@ void setup() {
     softSerial.begin(9600);
     delay(2000);
 
+#if !GF31_RAW_DATA
+    for (int i = 0; i < MAX_COEFFS; i++) {
+        original_data[i] = test_message[i];
+    }
+#endif
+
     Serial.println("=======================================================");
     Serial.println("       GF(31) RECEIVER - 1000 MESSAGE TEST");
     Serial.println("=======================================================");
@@ -422,22 +498,37 @@ void loop() {
             Serial.println();
         }
 
+#if GF31_COMPACT_PROTOCOL
+        // Whole frames of NUM_POINTS packed symbols, x = symbol position
+        int symbols[NUM_POINTS];
+        if (!parser.push(frame, symbols)) {
+            return;
+        }
+        for (int i = 0; i < NUM_POINTS; i++) {
+            points[i].x = i;
+            points[i].y = symbols[i];
+        }
+        count = NUM_POINTS;
+#else
+#if GF31_RAW_DATA
         // First receive 4 bytes of original data
         if (data_count < MAX_COEFFS) {
             original_data[data_count] = frame & 0x1F;
             data_count++;
             return;
         }
+#endif
 
-        // Then receive 6 encoded points
+        // Then receive NUM_POINTS encoded points
         int x = (frame >> 5) & 0x07;
         int y = frame & 0x1F;
 
         points[count].x = x;
         points[count].y = y;
         count++;
+#endif
 
-        if (count == 6) {
+        if (count == NUM_POINTS) {
             total_transmissions++;
 
             // Display progress every 100 messages
@@ -451,12 +542,16 @@ void loop() {
             bool is_corrected = false;
             bool is_ok = false;
 
-            // Check for duplicate x values
-            if (hasDuplicateX(points, 6)) {
-                // X duplicates detected - try all possible combinations of
-                // points
-                if (tryDecodeWithDuplicates(points, 6, decoded_coeffs)) {
+            // Check for duplicate (or, for the erasure decoder, out of
+            // range) x values
+            if (hasDuplicateX(points, NUM_POINTS) ||
+                (USE_ERASURE_DECODER && hasInvalidX(points, NUM_POINTS))) {
+                // X errors detected - decode with those points as erasures
+                // (or try all possible combinations of points)
+                if (tryDecodeWithDuplicates(points, NUM_POINTS,
+                                            decoded_coeffs)) {
                     // Successfully recreated polynomial despite x duplicates
+                    coeffs_to_message(decoded_coeffs);
                     corrected_transmissions++;
                     is_corrected = true;
                 } else {
@@ -467,7 +562,8 @@ void loop() {
                 // No duplicates - decode with error correction
                 int error_idx;
                 int error_count =
-                    reed_solomon_decode(points, 6, decoded_coeffs, &error_idx);
+                    reed_solomon_decode(points, NUM_POINTS, decoded_coeffs,
+                                        &error_idx);
 
                 if (error_count == 0) {
                     is_ok = true;
@@ -500,7 +596,7 @@ void loop() {
                                 example_original[i] = original_data[i];
                                 example_decoded[i] = decoded_coeffs[i];
                             }
-                            for (int i = 0; i < 6; i++) {
+                            for (int i = 0; i < NUM_POINTS; i++) {
                                 example_points[i] = points[i];
                             }
                         }
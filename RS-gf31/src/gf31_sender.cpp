@@ -2,11 +2,17 @@
 #include <SoftwareSerial.h>
 
 #include "gf31_math.hpp"
+#include "gf31_protocol.hpp"
+#include "reed_solomon.hpp"
+
+// RS(6, 4) over GF(31), the receiver's code
+typedef ReedSolomon<MOD, GF31_POINTS, MAX_COEFFS> GF31Code;
 
 // TX -> pin 12, RX -> pin 13
 SoftwareSerial softSerial(13, 12);  // RX, TX D7, D6
 
-int coeffs[MAX_COEFFS] = {5, 7, 3, 2};
+// Message: the data symbols (GF31_SYSTEMATIC) or the coefficients of f
+int coeffs[MAX_COEFFS] = GF31_TEST_MESSAGE;
 
 // Transmission modes:
 // 0 = clean (no errors)
@@ -15,21 +21,20 @@ int coeffs[MAX_COEFFS] = {5, 7, 3, 2};
 // 3 = 1 error in x
 // 4 = 1 error in x and 1 error in y
 // 5 = 2 errors in x
+// The compact wire format has no x field (GF31_COMPACT_PROTOCOL), so it
+// only offers modes 0-2.
+#if GF31_COMPACT_PROTOCOL
+const int MAX_MODE = 2;
+#else
+const int MAX_MODE = 5;
+#endif
 int transmission_mode = 0;  // Selected by user
 const int MESSAGES_PER_TEST = 1000;
 int messages_sent = 0;
 bool test_started = false;
 bool test_completed = false;
 
-int poly_eval(int x) {
-    int result = 0;
-    int power = 1;
-    for (int i = 0; i < MAX_COEFFS; i++) {
-        result = gf_add(result, gf_mul(coeffs[i], power));
-        power = gf_mul(power, x);
-    }
-    return result;
-}
+int poly_eval(int x) { return GF31Code::evaluate(coeffs, x); }
 
 void send_point(int x, int y) {
     uint8_t frame = ((x & 0x07) << 5) | (y & 0x1F);
@@ -64,15 +69,21 @@ void send_transmission() {
     int y_values[6];
 
     // Calculate all correct y values
-    for (int x = 0; x < 6; x++) {
-        y_values[x] = poly_eval(x);
-    }
-
-    // First, send the 4 original data coefficients (pure data without encoding)
+#if GF31_SYSTEMATIC
+    GF31Code::encode_systematic(coeffs, y_values);
+#else
+    GF31Code::encode(coeffs, y_values);
+#endif
+
+#if GF31_RAW_DATA
+    // First, send the 4 original data coefficients (pure data without
+    // encoding), the reference the receiver checks its decoding against.
+    // Systematic code symbols carry the data themselves.
     for (int i = 0; i < MAX_COEFFS; i++) {
         uint8_t data_byte = coeffs[i] & 0x1F;  // 5 bits for value in GF(31)
         softSerial.write(data_byte);
     }
+#endif
 
     // Introduce errors based on mode
     if (transmission_mode == 1) {
@@ -122,10 +133,19 @@ void send_transmission() {
         x_values[error_pos2] = introduce_x_error(x_values[error_pos2]);
     }
 
+#if GF31_COMPACT_PROTOCOL
+    // Send the y values as one packed frame, x is the position
+    uint8_t frame[GF31_FRAME_BYTES];
+    gf31_pack(y_values, frame);
+    for (int i = 0; i < GF31_FRAME_BYTES; i++) {
+        softSerial.write(frame[i]);
+    }
+#else
     // Send all points (silently)
     for (int i = 0; i < 6; i++) {
         send_point(x_values[i], y_values[i]);
     }
+#endif
 }
 
 void setup() {
@@ -142,11 +162,15 @@ void setup() {
     Serial.println("  0: CLEAN (no errors)");
     Serial.println("  1: 1 ERROR in Y");
     Serial.println("  2: 2 ERRORS in Y");
-    Serial.println("  3: 1 ERROR in X");
-    Serial.println("  4: 1 ERROR in X + 1 ERROR in Y");
-    Serial.println("  5: 2 ERRORS in X");
+    if (MAX_MODE >= 5) {
+        Serial.println("  3: 1 ERROR in X");
+        Serial.println("  4: 1 ERROR in X + 1 ERROR in Y");
+        Serial.println("  5: 2 ERRORS in X");
+    }
     Serial.println();
-    Serial.println("Enter mode number (0-5) and press Enter:");
+    Serial.print("Enter mode number (0-");
+    Serial.print(MAX_MODE);
+    Serial.println(") and press Enter:");
 }
 
 void loop() {
@@ -159,7 +183,7 @@ void loop() {
             Serial.read();
         }
 
-        if (input >= '0' && input <= '5') {
+        if (input >= '0' && input <= '0' + MAX_MODE) {
             transmission_mode = input - '0';
             test_started = true;
 
@@ -199,7 +223,9 @@ void loop() {
             Serial.println("START - Sending 1000 messages...");
             Serial.println();
         } else {
-            Serial.println("Invalid mode! Enter number from 0 to 5:");
+            Serial.print("Invalid mode! Enter number from 0 to ");
+            Serial.print(MAX_MODE);
+            Serial.println(":");
         }
     }
 